@@ -14,8 +14,11 @@ if not "%build_luau%"=="1" set build_luau=0
 echo ----- Compiling Shaders ------
 echo ------------------------------
 set shader_cl=source\third_party\sokol-tools\bin\win32\sokol-shdc.exe
+:: generated headers aren't checked in, they always come from the shaders
+if not exist source\generated mkdir source\generated
 %shader_cl% --input shaders\core3d.shader --output source\generated\core3d.h --slang hlsl5 --bytecode --errfmt msvc
 %shader_cl% --input shaders\compositor.shader --output source\generated\compositor.h --slang hlsl5 --bytecode --errfmt msvc
+%shader_cl% --input shaders\dither.shader --output source\generated\dither.h --slang hlsl5 --bytecode --errfmt msvc
 
 :: include directories
 set cl_includes= /I ..\source\
@@ -82,3 +85,12 @@ echo ------------------------------
 pushd build
 %compile% ..\source\main.cpp %cl_link% /out:polybox.exe
 popd
+
+:: userdata math benchmark, only built when asked for
+if "%bench%"=="1" (
+	echo --- Compiling Userdata Bench ---
+	echo --------------------------------
+	pushd build
+	%compile% ..\source\userdata_bench.cpp /link /incremental:no /subsystem:console /out:userdata_bench.exe
+	popd
+)
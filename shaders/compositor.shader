@@ -31,6 +31,8 @@ out vec4 frag_color;
 uniform fs_compositor_params {
 	vec2 screenResolution;
 	float time;
+	// fraction of the 3D target that was drawn to, when dynamic resolution has scaled it down
+	vec2 core3DScale;
 };
 
 uniform texture2D core2DFrame;
@@ -80,10 +82,10 @@ void main()
 	col2Dpixel.b = texture(sampler2D(core2DFrame, nearestSampler), vec2(x + uv.x + colorOffX.b, uv.y + colorOffY.b)).z + 0.1;
 	col2Dpixel.a = texture(sampler2D(core2DFrame, nearestSampler), vec2(x + uv.x + colorOffX.a, uv.y + colorOffY.a)).w;
 
-	col3Dpixel.r = texture(sampler2D(core3DFrame, nearestSampler), vec2(x + uv.x + colorOffX.r, uv.y + colorOffY.r)).x + 0.1;
-	col3Dpixel.g = texture(sampler2D(core3DFrame, nearestSampler), vec2(x + uv.x + colorOffX.g, uv.y + colorOffY.g)).y + 0.1;
-	col3Dpixel.b = texture(sampler2D(core3DFrame, nearestSampler), vec2(x + uv.x + colorOffX.b, uv.y + colorOffY.b)).z + 0.1;
-	col3Dpixel.a = texture(sampler2D(core3DFrame, nearestSampler), vec2(x + uv.x + colorOffX.a, uv.y + colorOffY.a)).w;
+	col3Dpixel.r = texture(sampler2D(core3DFrame, nearestSampler), vec2(x + uv.x + colorOffX.r, uv.y + colorOffY.r) * core3DScale).x + 0.1;
+	col3Dpixel.g = texture(sampler2D(core3DFrame, nearestSampler), vec2(x + uv.x + colorOffX.g, uv.y + colorOffY.g) * core3DScale).y + 0.1;
+	col3Dpixel.b = texture(sampler2D(core3DFrame, nearestSampler), vec2(x + uv.x + colorOffX.b, uv.y + colorOffY.b) * core3DScale).z + 0.1;
+	col3Dpixel.a = texture(sampler2D(core3DFrame, nearestSampler), vec2(x + uv.x + colorOffX.a, uv.y + colorOffY.a) * core3DScale).w;
 
 	// alpha blend the two framebuffers together
 	vec4 col = mix(col3Dpixel, col2Dpixel, col2Dpixel.a);
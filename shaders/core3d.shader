@@ -3,18 +3,19 @@
 @ctype vec3 Vec3f 
 @ctype vec2 Vec2f 
 
-@vs vs_core3D
+// Shared vertex code, compiled into variants by the defines at the top of each snippet
+// LIGHTING: apply the directional light, FOG: compute fog density for the fragment shader
+@block vs_core3D_main
 uniform vs_core3d_params {
 	mat4 mvp;
 	mat4 model;
 	mat4 modelView;
-	int lightingEnabled;
 	vec4 lightDirection[3];
 	vec4 lightColor[3];
 	vec3 lightAmbient;
-	int fogEnabled;
 	vec2 fogDepths;
 	vec2 targetResolution;
+	vec4 unpackScale;
 };
 
 layout(location=0) in vec3 pos;
@@ -27,8 +28,11 @@ noperspective out vec2 uv;
 out float fogDensity;
 
 void main() {
+	// packed vertex formats arrive normalized, so restore their real range
+	vec3 position = pos * unpackScale.xyz;
+
 	vec2 resolution = targetResolution.xy * 0.5;
-    vec4 vert = mvp * vec4(pos, 1.0);
+    vec4 vert = mvp * vec4(position, 1.0);
 
 	// Snap vertices to screen pixels
 	vec4 snapped = vert;
@@ -38,30 +42,31 @@ void main() {
 
 	gl_Position = snapped;
 
-	if (fogEnabled == 1)
-	{
-		vec4 depthVert = modelView * vec4(pos, 1.0);
-		float depth = abs(depthVert.z / depthVert.w);
-		fogDensity = 1.0 - clamp((fogDepths.y - depth) / (fogDepths.y - fogDepths.x), 0.0, 1.0);
-	}
-
-	if (lightingEnabled == 0)
-	{
-		color = color0;
-	}
-	else if (lightingEnabled == 1)
-	{
-		vec3 norm = (model * vec4(normal, 0.0)).xyz;
-		float lightMag = max(dot(normalize(lightDirection[0].xyz), norm.xyz), 0.0);
-		vec3 diffuse = lightMag * lightColor[0].xyz;
-
-		color = vec4(color0.xyz * (lightAmbient.xyz + diffuse), color0.w);
-	}
-	uv = texcoord;
+#ifdef FOG
+	vec4 depthVert = modelView * vec4(position, 1.0);
+	float depth = abs(depthVert.z / depthVert.w);
+	fogDensity = 1.0 - clamp((fogDepths.y - depth) / (fogDepths.y - fogDepths.x), 0.0, 1.0);
+#else
+	fogDensity = 0.0;
+#endif
+
+#ifdef LIGHTING
+	vec3 norm = (model * vec4(normal, 0.0)).xyz;
+	float lightMag = max(dot(normalize(lightDirection[0].xyz), norm.xyz), 0.0);
+	vec3 diffuse = lightMag * lightColor[0].xyz;
+
+	color = vec4(color0.xyz * (lightAmbient.xyz + diffuse), color0.w);
+#else
+	color = color0;
+#endif
+	uv = texcoord * unpackScale.w;
 }
 @end
 
-@fs fs_core3D
+// Shared fragment code
+// FOG: blend towards the fog colour, TEXTURED: sample tex, VRAM: sample a texture page out of vram
+// ARRAY: sample a layer of a texture array, the layer is carried in u in steps of 16
+@block fs_core3D_main
 noperspective in vec4 color;
 noperspective in vec2 uv;
 in float fogDensity;
@@ -69,90 +74,166 @@ out vec4 frag_color;
 
 uniform fs_core3d_params {
 	vec4 fogColor;
+	// xy: texture page origin in vram pixels, z: 0 4 bit clut, 1 8 bit clut, 2 direct 15 bit
+	vec4 vramPage;
+	// xy: clut origin in vram pixels
+	vec4 vramClut;
 };
 
+#ifdef VRAM
+uniform utexture2D tex;
+#elif defined(ARRAY)
+uniform texture2DArray tex;
+#else
 uniform texture2D tex;
+#endif
 uniform sampler nearestSampler;
 
-vec4 RGBtoYUV(vec4 rgba) {
-	vec4 yuva;
-	yuva.r = rgba.r * 0.2126 + 0.7152 * rgba.g + 0.0722 * rgba.b;
-	yuva.g = (rgba.b - yuva.r) / 1.8556;
-	yuva.b = (rgba.r - yuva.r) / 1.5748;
-	yuva.a = rgba.a;
-	
-	// Adjust to work on GPU
-	yuva.gb += 0.5;
-	
-	return yuva;
-}
-
-vec4 YUVtoRGB(vec4 yuva) {
-	yuva.gb -= 0.5;
-	return vec4(
-		yuva.r * 1 + yuva.g * 0 + yuva.b * 1.5748,
-		yuva.r * 1 + yuva.g * -0.187324 + yuva.b * -0.468124,
-		yuva.r * 1 + yuva.g * 1.8556 + yuva.b * 0,
-		yuva.a);
+#ifdef VRAM
+uint FetchVram(ivec2 pixel) {
+	return texelFetch(usampler2D(tex, nearestSampler), pixel, 0).r;
 }
 
-float dither8x8(vec2 position, float brightness)
-{
-	int x = int(mod(position.x, 8.0));
-  	int y = int(mod(position.y, 8.0));
-
-	int dither[8][8] = {
-	{ 0, 32, 8, 40, 2, 34, 10, 42}, /* 8x8 Bayer ordered dithering */
-	{48, 16, 56, 24, 50, 18, 58, 26}, /* pattern. Each input pixel */
-	{12, 44, 4, 36, 14, 46, 6, 38}, /* is scaled to the 0..63 range */
-	{60, 28, 52, 20, 62, 30, 54, 22}, /* before looking in this table */
-	{ 3, 35, 11, 43, 1, 33, 9, 41}, /* to determine th  e action. */
-	{51, 19, 59, 27, 49, 17, 57, 25},
-	{15, 47, 7, 39, 13, 45, 5, 37},
-	{63, 31, 55, 23, 61, 29, 53, 21} }; 
-
-	float limit = 0.0;
-	if(x < 8)
-		limit = (dither[x][y]+1)/64.0;
-
-	return brightness < limit ? 0.0 : 1.0;
-}
-
-float ditherChannelError(float col, float colMin, float colMax)
-{
-	float range = abs(colMin - colMax);
-	float aRange = abs(col - colMin);
-	return aRange /range;
-}
-
-vec4 ditherAndPosterize(vec2 position, vec4 color, int colorDepth)
-{
-	vec4 yuv = RGBtoYUV(color);
-
-	vec4 col1 = floor(yuv * colorDepth) / colorDepth;
-	vec4 col2 = ceil(yuv * colorDepth) / colorDepth;
-
-	yuv.x = mix(col1.x, col2.x, dither8x8(position, ditherChannelError(yuv.x, col1.x, col2.x)));
-	yuv.y = mix(col1.y, col2.y, dither8x8(position, ditherChannelError(yuv.y, col1.y, col2.y)));
-	yuv.z = mix(col1.z, col2.z, dither8x8(position, ditherChannelError(yuv.z, col1.z, col2.z)));
+vec4 SampleVram(vec2 texcoord) {
+	// pages are 256x256 texels and wrap, uvs are in texels
+	ivec2 texel = ivec2(floor(texcoord)) & 255;
+	ivec2 page = ivec2(vramPage.xy);
+	int mode = int(vramPage.z);
+
+	uint value;
+	if (mode == 0) {
+		// four indices packed into each vram pixel
+		uint packed = FetchVram(page + ivec2(texel.x >> 2, texel.y));
+		uint index = (packed >> uint((texel.x & 3) * 4)) & 15u;
+		value = FetchVram(ivec2(vramClut.xy) + ivec2(int(index), 0));
+	}
+	else if (mode == 1) {
+		uint packed = FetchVram(page + ivec2(texel.x >> 1, texel.y));
+		uint index = (packed >> uint((texel.x & 1) * 8)) & 255u;
+		value = FetchVram(ivec2(vramClut.xy) + ivec2(int(index), 0));
+	}
+	else {
+		value = FetchVram(page + texel);
+	}
 
-	return YUVtoRGB(yuv);
+	// like the ps1, a colour of zero is transparent
+	if (value == 0u) {
+		return vec4(0.0);
+	}
+	return vec4(float(value & 31u), float((value >> 5) & 31u), float((value >> 10) & 31u), 31.0) / 31.0;
 }
+#endif
 
 void main() {
+#ifdef TEXTURED
 	vec4 colorTextured = color * texture(sampler2D(tex, nearestSampler), uv);
+#elif defined(VRAM)
+	vec4 colorTextured = color * SampleVram(uv);
+#elif defined(ARRAY)
+	// uvs are in [-8, 8) within a layer, so whole triangles stay in one layer's band
+	float layer = floor((uv.x + 8.0) / 16.0);
+	vec4 colorTextured = color * texture(sampler2DArray(tex, nearestSampler), vec3(uv.x - layer * 16.0, uv.y, layer));
+#else
+	vec4 colorTextured = color;
+#endif
 	if (colorTextured.a <= 0.01) {
 		discard;
 	}
 
+#ifdef FOG
 	vec3 fog_output = mix(colorTextured.rgb, fogColor.rgb, fogDensity);
 	frag_color = vec4(fog_output, colorTextured.a);
+#else
+	frag_color = colorTextured;
+#endif
 
-	// 32 color depth means 32 values are possible per component
-	// which is 2^5, so it's a 15 bit pixel format
-	frag_color = ditherAndPosterize(gl_FragCoord.xy, frag_color, 32);
 }
 @end
 
-@program core3D vs_core3D fs_core3D
+// Vertex variants
+
+@vs vs_core3D
+@include_block vs_core3D_main
+@end
+
+@vs vs_core3D_lit
+#define LIGHTING
+@include_block vs_core3D_main
+@end
+
+@vs vs_core3D_fog
+#define FOG
+@include_block vs_core3D_main
+@end
+
+@vs vs_core3D_lit_fog
+#define LIGHTING
+#define FOG
+@include_block vs_core3D_main
+@end
+
+// Fragment variants
+
+@fs fs_core3D
+@include_block fs_core3D_main
+@end
+
+@fs fs_core3D_fog
+#define FOG
+@include_block fs_core3D_main
+@end
+
+@fs fs_core3D_tex
+#define TEXTURED
+@include_block fs_core3D_main
+@end
 
+@fs fs_core3D_fog_tex
+#define FOG
+#define TEXTURED
+@include_block fs_core3D_main
+@end
+
+@fs fs_core3D_vram
+@sampler_type nearestSampler nonfiltering
+#define VRAM
+@include_block fs_core3D_main
+@end
+
+@fs fs_core3D_fog_vram
+@sampler_type nearestSampler nonfiltering
+#define FOG
+#define VRAM
+@include_block fs_core3D_main
+@end
+
+@fs fs_core3D_array
+#define ARRAY
+@include_block fs_core3D_main
+@end
+
+@fs fs_core3D_fog_array
+#define FOG
+#define ARRAY
+@include_block fs_core3D_main
+@end
+
+// Programs, ordered to match the variant bits in graphics.cpp (lit, fog, textured, vram, array)
+// textured, vram and array are never set together, so only the first of each block exists
+
+@program core3D vs_core3D fs_core3D
+@program core3D_lit vs_core3D_lit fs_core3D
+@program core3D_fog vs_core3D_fog fs_core3D_fog
+@program core3D_lit_fog vs_core3D_lit_fog fs_core3D_fog
+@program core3D_tex vs_core3D fs_core3D_tex
+@program core3D_lit_tex vs_core3D_lit fs_core3D_tex
+@program core3D_fog_tex vs_core3D_fog fs_core3D_fog_tex
+@program core3D_lit_fog_tex vs_core3D_lit_fog fs_core3D_fog_tex
+@program core3D_vram vs_core3D fs_core3D_vram
+@program core3D_lit_vram vs_core3D_lit fs_core3D_vram
+@program core3D_fog_vram vs_core3D_fog fs_core3D_fog_vram
+@program core3D_lit_fog_vram vs_core3D_lit_fog fs_core3D_fog_vram
+@program core3D_array vs_core3D fs_core3D_array
+@program core3D_lit_array vs_core3D_lit fs_core3D_array
+@program core3D_fog_array vs_core3D_fog fs_core3D_fog_array
+@program core3D_lit_fog_array vs_core3D_lit_fog fs_core3D_fog_array
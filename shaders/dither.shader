@@ -0,0 +1,80 @@
+// Copyright 2020-2024 David Colson. All rights reserved.
+
+@ctype mat4 Matrixf 
+@ctype vec4 Vec4f 
+
+// Full screen quantise and dither of a 320x240 layer down to a 15 bit look
+// the ordered dither thresholds come from a small repeating pattern texture
+
+@vs vs_dither
+uniform vs_dither_params {
+	mat4 mvp;
+};
+
+layout(location=0) in vec3 pos;
+layout(location=1) in vec4 color0;
+layout(location=2) in vec2 texcoord;
+layout(location=3) in vec3 normal;
+
+void main()
+{
+    gl_Position = mvp * vec4(pos, 1.0);
+}
+@end
+
+@fs fs_dither
+out vec4 frag_color;
+
+uniform fs_dither_params {
+	// x: values per channel, y: size of the dither pattern in pixels
+	vec4 ditherParams;
+};
+
+uniform texture2D sourceFrame;
+uniform texture2D ditherPattern;
+uniform sampler nearestSampler;
+
+vec4 RGBtoYUV(vec4 rgba) {
+	vec4 yuva;
+	yuva.r = rgba.r * 0.2126 + 0.7152 * rgba.g + 0.0722 * rgba.b;
+	yuva.g = (rgba.b - yuva.r) / 1.8556;
+	yuva.b = (rgba.r - yuva.r) / 1.5748;
+	yuva.a = rgba.a;
+	
+	// Adjust to work on GPU
+	yuva.gb += 0.5;
+	
+	return yuva;
+}
+
+vec4 YUVtoRGB(vec4 yuva) {
+	yuva.gb -= 0.5;
+	return vec4(
+		yuva.r * 1 + yuva.g * 0 + yuva.b * 1.5748,
+		yuva.r * 1 + yuva.g * -0.187324 + yuva.b * -0.468124,
+		yuva.r * 1 + yuva.g * 1.8556 + yuva.b * 0,
+		yuva.a);
+}
+
+void main()
+{
+	// both targets are the same size, so we can work in whole pixels
+	ivec2 pixel = ivec2(gl_FragCoord.xy);
+	vec4 color = texelFetch(sampler2D(sourceFrame, nearestSampler), pixel, 0);
+
+	int patternSize = int(ditherParams.y);
+	float threshold = texelFetch(sampler2D(ditherPattern, nearestSampler), pixel % patternSize, 0).r;
+
+	// pick the lower or upper quantised value depending on how far between them we are
+	vec4 yuv = RGBtoYUV(color);
+	float levels = ditherParams.x;
+	vec3 lower = floor(yuv.xyz * levels) / levels;
+	vec3 upper = ceil(yuv.xyz * levels) / levels;
+	vec3 error = (yuv.xyz - lower) / max(upper - lower, vec3(0.00001));
+	yuv.xyz = mix(lower, upper, step(vec3(threshold), error));
+
+	frag_color = YUVtoRGB(yuv);
+}
+@end
+
+@program dither vs_dither fs_dither
@@ -1,5 +1,8 @@
 namespace AssetImporter {
 
+#define MAX_MESH_LODS 3
+#define MIN_LOD_TRIANGLES 8
+
 // ***********************************************************************
 
 static void* LuaAllocator(void* ud, void* ptr, u64 osize, u64 nsize) {
@@ -176,7 +179,738 @@ struct GltfAccessor {
 
 // ***********************************************************************
 
-bool ImportGltf(Arena* pArena, lua_State* L, u8 format, String source) {
+// Mesh simplification for LOD generation, this is a quadric error metric edge collapse
+// in the style of Garland & Heckbert, but using the threshold sweep approach rather than
+// a priority queue. We only ever collapse a vertex onto one of its neighbours (half edge collapse)
+// so no vertex attributes need interpolating, and border vertices (which includes uv and normal seams,
+// since those are split in the index buffer) are never moved, so the mesh won't tear
+
+struct Quadric {
+	f64 a[10] { 0 };
+
+	void AddPlane(Vec3f n, f32 d, f32 weight) {
+		a[0] += weight * n.x * n.x; a[1] += weight * n.x * n.y; a[2] += weight * n.x * n.z; a[3] += weight * n.x * d;
+		a[4] += weight * n.y * n.y; a[5] += weight * n.y * n.z; a[6] += weight * n.y * d;
+		a[7] += weight * n.z * n.z; a[8] += weight * n.z * d;
+		a[9] += weight * d * d;
+	}
+
+	void Add(const Quadric& other) {
+		for (i32 i = 0; i < 10; i++) a[i] += other.a[i];
+	}
+
+	f64 Error(Vec3f p) const {
+		f64 x = p.x, y = p.y, z = p.z;
+		return a[0]*x*x + 2*a[1]*x*y + 2*a[2]*x*z + 2*a[3]*x
+			+ a[4]*y*y + 2*a[5]*y*z + 2*a[6]*y
+			+ a[7]*z*z + 2*a[8]*z
+			+ a[9];
+	}
+};
+
+struct Simplifier {
+	ResizableArray<Vec3f> positions;
+	ResizableArray<Quadric> quadrics;
+	ResizableArray<bool> border;
+	ResizableArray<u32> indices;
+	ResizableArray<bool> deleted;
+	i32 triangleCount;
+};
+
+// ***********************************************************************
+
+void BuildAdjacency(Simplifier& simp, ResizableArray<i32>& adjStart, ResizableArray<i32>& adjTris) {
+	i32 nVerts = (i32)simp.positions.count;
+	i32 nTris = (i32)simp.indices.count / 3;
+
+	adjStart.count = 0;
+	for (i32 i = 0; i < nVerts + 1; i++) adjStart.PushBack(0);
+	for (i32 t = 0; t < nTris; t++) {
+		if (simp.deleted[t]) continue;
+		for (i32 j = 0; j < 3; j++) adjStart[simp.indices[t*3+j] + 1]++;
+	}
+	for (i32 i = 0; i < nVerts; i++) adjStart[i + 1] += adjStart[i];
+
+	adjTris.count = 0;
+	for (i32 i = 0; i < adjStart[nVerts]; i++) adjTris.PushBack(0);
+
+	// use the tail of adjStart as a write cursor, then shift it back
+	for (i32 t = 0; t < nTris; t++) {
+		if (simp.deleted[t]) continue;
+		for (i32 j = 0; j < 3; j++) {
+			u32 v = simp.indices[t*3+j];
+			adjTris[adjStart[v]++] = t;
+		}
+	}
+	for (i32 i = nVerts; i > 0; i--) adjStart[i] = adjStart[i - 1];
+	adjStart[0] = 0;
+}
+
+// ***********************************************************************
+
+bool CollapseFlipsTriangle(Simplifier& simp, ResizableArray<i32>& adjStart, ResizableArray<i32>& adjTris, u32 from, u32 to) {
+	Vec3f target = simp.positions[to];
+	for (i32 k = adjStart[from]; k < adjStart[from + 1]; k++) {
+		i32 t = adjTris[k];
+		if (simp.deleted[t]) continue;
+
+		u32* pTri = &simp.indices[t*3];
+		if (pTri[0] == to || pTri[1] == to || pTri[2] == to) continue; // this one will be removed
+
+		Vec3f p[3];
+		Vec3f q[3];
+		for (i32 j = 0; j < 3; j++) {
+			p[j] = simp.positions[pTri[j]];
+			q[j] = pTri[j] == from ? target : p[j];
+		}
+		Vec3f before = Vec3f::Cross(p[1] - p[0], p[2] - p[0]);
+		Vec3f after = Vec3f::Cross(q[1] - q[0], q[2] - q[0]);
+		f32 lenBefore = sqrtf(Vec3f::Dot(before, before));
+		f32 lenAfter = sqrtf(Vec3f::Dot(after, after));
+		if (lenAfter < 0.000001f)
+			return true;
+		if (Vec3f::Dot(before, after) < 0.2f * lenBefore * lenAfter)
+			return true;
+	}
+	return false;
+}
+
+// ***********************************************************************
+
+void InitSimplifier(Arena* pArena, Simplifier& simp, ResizableArray<VertexData>& vertices, u16* pIndices, i32 nIndices) {
+	simp.positions.pArena = pArena;
+	simp.quadrics.pArena = pArena;
+	simp.border.pArena = pArena;
+	simp.indices.pArena = pArena;
+	simp.deleted.pArena = pArena;
+
+	// work in a normalized space so error thresholds don't depend on the size of the model
+	Vec3f minPos = vertices[0].pos;
+	Vec3f maxPos = vertices[0].pos;
+	for (i32 i = 0; i < vertices.count; i++) {
+		minPos = Vec3f(min(minPos.x, vertices[i].pos.x), min(minPos.y, vertices[i].pos.y), min(minPos.z, vertices[i].pos.z));
+		maxPos = Vec3f(max(maxPos.x, vertices[i].pos.x), max(maxPos.y, vertices[i].pos.y), max(maxPos.z, vertices[i].pos.z));
+	}
+	Vec3f extent = maxPos - minPos;
+	f32 scale = max(extent.x, max(extent.y, extent.z));
+	scale = scale > 0.0f ? 1.0f / scale : 1.0f;
+
+	simp.positions.Reserve(vertices.count);
+	simp.quadrics.Reserve(vertices.count);
+	simp.border.Reserve(vertices.count);
+	for (i32 i = 0; i < vertices.count; i++) {
+		simp.positions.PushBack((vertices[i].pos - minPos) * scale);
+		simp.quadrics.PushBack(Quadric());
+		simp.border.PushBack(false);
+	}
+
+	simp.indices.Reserve(nIndices);
+	simp.deleted.Reserve(nIndices / 3);
+	for (i32 i = 0; i < nIndices; i++) {
+		simp.indices.PushBack(pIndices[i]);
+	}
+	simp.triangleCount = nIndices / 3;
+	for (i32 t = 0; t < simp.triangleCount; t++) {
+		simp.deleted.PushBack(false);
+	}
+
+	// accumulate area weighted plane quadrics
+	for (i32 t = 0; t < simp.triangleCount; t++) {
+		u32* pTri = &simp.indices[t*3];
+		Vec3f p0 = simp.positions[pTri[0]];
+		Vec3f cross = Vec3f::Cross(simp.positions[pTri[1]] - p0, simp.positions[pTri[2]] - p0);
+		f32 len = sqrtf(Vec3f::Dot(cross, cross));
+		if (len < 0.0000001f) continue;
+
+		Vec3f n = cross * (1.0f / len);
+		f32 d = -Vec3f::Dot(n, p0);
+		for (i32 j = 0; j < 3; j++) {
+			simp.quadrics[pTri[j]].AddPlane(n, d, len * 0.5f);
+		}
+	}
+
+	// a vertex is on a border if any of its edges is used by only one triangle
+	ResizableArray<i32> adjStart(pArena);
+	ResizableArray<i32> adjTris(pArena);
+	BuildAdjacency(simp, adjStart, adjTris);
+	for (u32 v = 0; v < (u32)simp.positions.count; v++) {
+		for (i32 k = adjStart[v]; k < adjStart[v + 1] && !simp.border[v]; k++) {
+			u32* pTri = &simp.indices[adjTris[k]*3];
+			for (i32 j = 0; j < 3; j++) {
+				u32 other = pTri[j];
+				if (other == v) continue;
+
+				i32 uses = 0;
+				for (i32 k2 = adjStart[v]; k2 < adjStart[v + 1]; k2++) {
+					u32* pTri2 = &simp.indices[adjTris[k2]*3];
+					if (pTri2[0] == other || pTri2[1] == other || pTri2[2] == other) uses++;
+				}
+				if (uses == 1) {
+					simp.border[v] = true;
+					break;
+				}
+			}
+		}
+	}
+}
+
+// ***********************************************************************
+
+void SimplifyToTarget(Arena* pArena, Simplifier& simp, i32 targetTriangles) {
+	ResizableArray<i32> adjStart(pArena);
+	ResizableArray<i32> adjTris(pArena);
+	ResizableArray<bool> dirty(pArena);
+	dirty.Reserve(simp.positions.count);
+	for (i32 i = 0; i < simp.positions.count; i++) dirty.PushBack(false);
+
+	i32 nTris = (i32)simp.indices.count / 3;
+	for (i32 iteration = 0; iteration < 100 && simp.triangleCount > targetTriangles; iteration++) {
+		// allowed error grows each pass, so cheap collapses happen first
+		f64 threshold = 0.000000001 * pow((f64)(iteration + 3), 7.0);
+
+		BuildAdjacency(simp, adjStart, adjTris);
+		for (i32 i = 0; i < dirty.count; i++) dirty[i] = false;
+
+		for (i32 t = 0; t < nTris && simp.triangleCount > targetTriangles; t++) {
+			if (simp.deleted[t]) continue;
+			u32* pTri = &simp.indices[t*3];
+			if (dirty[pTri[0]] || dirty[pTri[1]] || dirty[pTri[2]]) continue;
+
+			for (i32 j = 0; j < 3; j++) {
+				u32 a = pTri[j];
+				u32 b = pTri[(j + 1) % 3];
+
+				// pick the cheaper direction that's allowed
+				f64 costAB = simp.border[a] ? 1e30 : simp.quadrics[a].Error(simp.positions[b]) + simp.quadrics[b].Error(simp.positions[b]);
+				f64 costBA = simp.border[b] ? 1e30 : simp.quadrics[b].Error(simp.positions[a]) + simp.quadrics[a].Error(simp.positions[a]);
+				u32 from = costAB <= costBA ? a : b;
+				u32 to = costAB <= costBA ? b : a;
+				if (min(costAB, costBA) > threshold) continue;
+				if (CollapseFlipsTriangle(simp, adjStart, adjTris, from, to)) continue;
+
+				// collapse
+				for (i32 k = adjStart[from]; k < adjStart[from + 1]; k++) {
+					i32 t2 = adjTris[k];
+					if (simp.deleted[t2]) continue;
+					u32* pTri2 = &simp.indices[t2*3];
+					if (pTri2[0] == to || pTri2[1] == to || pTri2[2] == to) {
+						simp.deleted[t2] = true;
+						simp.triangleCount--;
+						continue;
+					}
+					for (i32 j2 = 0; j2 < 3; j2++) {
+						if (pTri2[j2] == from) pTri2[j2] = to;
+						dirty[pTri2[j2]] = true;
+					}
+				}
+				simp.quadrics[to].Add(simp.quadrics[from]);
+				dirty[from] = true;
+				dirty[to] = true;
+				break;
+			}
+		}
+	}
+}
+
+// ***********************************************************************
+
+void PushSimplifiedVertices(lua_State* L, Simplifier& simp, ResizableArray<VertexData>& vertices) {
+	i32 floatsPerVertex = sizeof(VertexData) / sizeof(f32);
+	UserData* pUserData = AllocUserData(L, Type::Float32, floatsPerVertex*simp.triangleCount*3, 1);
+	VertexData* pOut = (VertexData*)pUserData->pData;
+
+	i32 nTris = (i32)simp.indices.count / 3;
+	for (i32 t = 0; t < nTris; t++) {
+		if (simp.deleted[t]) continue;
+		for (i32 j = 0; j < 3; j++) {
+			*pOut++ = vertices[simp.indices[t*3+j]];
+		}
+	}
+}
+
+// ***********************************************************************
+
+// Vertex lighting bake. Matches the core3D lit vertex shader for light 0, with the ambient term
+// scaled by an occlusion estimate from rays cast over the hemisphere around each vertex normal.
+// Only the mesh itself occludes, and it's done in mesh space, so node rotations aren't accounted for
+
+#define BAKE_AO_SAMPLES 32
+#define BAKE_AO_DISTANCE 0.1f // fraction of the mesh's bounding box diagonal
+
+// ***********************************************************************
+
+bool RayHitsTriangle(Vec3f origin, Vec3f dir, f32 maxDistance, Vec3f p0, Vec3f p1, Vec3f p2) {
+	// Moller-Trumbore, both sides count as hits
+	Vec3f edge1 = p1 - p0;
+	Vec3f edge2 = p2 - p0;
+	Vec3f pvec = Vec3f::Cross(dir, edge2);
+	f32 det = Vec3f::Dot(edge1, pvec);
+	if (fabsf(det) < 0.0000001f)
+		return false;
+
+	f32 invDet = 1.0f / det;
+	Vec3f tvec = origin - p0;
+	f32 u = Vec3f::Dot(tvec, pvec) * invDet;
+	if (u < 0.0f || u > 1.0f)
+		return false;
+
+	Vec3f qvec = Vec3f::Cross(tvec, edge1);
+	f32 v = Vec3f::Dot(dir, qvec) * invDet;
+	if (v < 0.0f || u + v > 1.0f)
+		return false;
+
+	f32 t = Vec3f::Dot(edge2, qvec) * invDet;
+	return t > 0.0f && t < maxDistance;
+}
+
+// ***********************************************************************
+
+void BakeVertexLighting(Arena* pArena, ResizableArray<VertexData>& vertices, u16* pIndices, i32 nIndices, ImportOptions& options) {
+	if (vertices.count == 0)
+		return;
+
+	Vec3f minPos = vertices[0].pos;
+	Vec3f maxPos = vertices[0].pos;
+	for (i32 i = 0; i < vertices.count; i++) {
+		minPos = Vec3f(min(minPos.x, vertices[i].pos.x), min(minPos.y, vertices[i].pos.y), min(minPos.z, vertices[i].pos.z));
+		maxPos = Vec3f(max(maxPos.x, vertices[i].pos.x), max(maxPos.y, vertices[i].pos.y), max(maxPos.z, vertices[i].pos.z));
+	}
+	Vec3f extent = maxPos - minPos;
+	f32 aoDistance = max(sqrtf(Vec3f::Dot(extent, extent)) * BAKE_AO_DISTANCE, 0.0001f);
+
+	// bounding spheres, so each vertex only tests the triangles that could be within reach
+	i32 nTris = nIndices / 3;
+	ResizableArray<Vec4f> triSpheres(pArena);
+	triSpheres.Reserve(nTris);
+	for (i32 t = 0; t < nTris; t++) {
+		Vec3f p0 = vertices[pIndices[t*3]].pos;
+		Vec3f p1 = vertices[pIndices[t*3+1]].pos;
+		Vec3f p2 = vertices[pIndices[t*3+2]].pos;
+		Vec3f center = (p0 + p1 + p2) * (1.0f / 3.0f);
+		f32 radiusSq = max(Vec3f::Dot(p0 - center, p0 - center), max(Vec3f::Dot(p1 - center, p1 - center), Vec3f::Dot(p2 - center, p2 - center)));
+		triSpheres.PushBack(Vec4f(center.x, center.y, center.z, sqrtf(radiusSq)));
+	}
+
+	Vec3f lightDirection = options.lightDirection.GetNormalized();
+	ResizableArray<i32> nearby(pArena);
+	for (i32 i = 0; i < vertices.count; i++) {
+		VertexData& vert = vertices[i];
+		Vec3f normal = Vec3f::Dot(vert.norm, vert.norm) > 0.0f ? vert.norm.GetNormalized() : Vec3f(0.0f, 1.0f, 0.0f);
+
+		nearby.count = 0;
+		for (i32 t = 0; t < nTris; t++) {
+			Vec3f toTri = Vec3f(triSpheres[t].x, triSpheres[t].y, triSpheres[t].z) - vert.pos;
+			f32 reach = aoDistance + triSpheres[t].w;
+			if (Vec3f::Dot(toTri, toTri) <= reach * reach)
+				nearby.PushBack(t);
+		}
+
+		Vec3f tangent = Vec3f::Cross(normal, fabsf(normal.x) > 0.9f ? Vec3f(0.0f, 1.0f, 0.0f) : Vec3f(1.0f, 0.0f, 0.0f)).GetNormalized();
+		Vec3f bitangent = Vec3f::Cross(normal, tangent);
+
+		// nudged off the surface so the vertex doesn't hit its own triangles
+		Vec3f origin = vert.pos + normal * (aoDistance * 0.01f);
+		i32 unoccluded = 0;
+		for (i32 s = 0; s < BAKE_AO_SAMPLES; s++) {
+			// stratified cosine weighted directions, fixed so reimports give the same result
+			f32 u1 = (s + 0.5f) / BAKE_AO_SAMPLES;
+			f32 u2 = fmodf(s * 0.618034f, 1.0f);
+			f32 r = sqrtf(u1);
+			f32 phi = 6.2831853f * u2;
+			Vec3f dir = tangent * (r * cosf(phi)) + bitangent * (r * sinf(phi)) + normal * sqrtf(1.0f - u1);
+
+			bool hit = false;
+			for (i32 k = 0; k < nearby.count && !hit; k++) {
+				u16* pTri = &pIndices[nearby[k] * 3];
+				hit = RayHitsTriangle(origin, dir, aoDistance, vertices[pTri[0]].pos, vertices[pTri[1]].pos, vertices[pTri[2]].pos);
+			}
+			if (!hit)
+				unoccluded++;
+		}
+		f32 occlusion = (f32)unoccluded / BAKE_AO_SAMPLES;
+
+		f32 diffuse = max(Vec3f::Dot(lightDirection, normal), 0.0f);
+		Vec3f light = options.ambient * occlusion + options.lightColor * diffuse;
+		vert.col = Vec4f(vert.col.x * light.x, vert.col.y * light.y, vert.col.z * light.z, vert.col.w);
+	}
+}
+
+// ***********************************************************************
+
+// Potentially visible sets for indoor scenes. The scene's triangles are voxelised into a coarse grid,
+// then from the centre of every empty cell inside some node's bounds, lines are walked cell by cell to
+// the cells each node's bounds cover (shrunk by half a cell, so a room's own walls still occlude). A node
+// is visible from a cell if any of its cells can be reached without passing through a solid cell first.
+// This is conservative in the direction of drawing too much, every empty cell a line passes through
+// counts as seen, and lines through the corner between two solid cells slip past them
+
+#define PVS_MAX_CELLS_PER_AXIS 32
+
+struct PvsNode {
+	String name;
+	i32 parent;
+	Vec3f boundsMin;
+	Vec3f boundsMax;
+};
+
+struct PvsGrid {
+	Vec3f origin;
+	f32 cellSize;
+	i32 dims[3];
+	bool* pSolid;
+};
+
+// ***********************************************************************
+
+void CollectPvsNodes(JsonValue& gltf, ResizableArray<GltfAccessor>& accessors, i32 nodeId, i32 parent, Matrixf parentWorld, ResizableArray<PvsNode>& nodes, ResizableArray<Vec3f>& triangles) {
+	JsonValue& jsonNode = gltf["nodes"][nodeId];
+
+	// same transform order as the scripts use, translate, scale, then rotate
+	Matrixf world = parentWorld;
+	if (jsonNode.HasKey("translation")) {
+		JsonValue& t = jsonNode["translation"];
+		world *= Matrixf::MakeTranslation(Vec3f((f32)t[0].ToFloat(), (f32)t[1].ToFloat(), (f32)t[2].ToFloat()));
+	}
+	if (jsonNode.HasKey("scale")) {
+		JsonValue& s = jsonNode["scale"];
+		world *= Matrixf::MakeScale(Vec3f((f32)s[0].ToFloat(), (f32)s[1].ToFloat(), (f32)s[2].ToFloat()));
+	}
+	if (jsonNode.HasKey("rotation")) {
+		JsonValue& q = jsonNode["rotation"];
+		f32 w = clamp((f32)q[3].ToFloat(), -1.0f, 1.0f);
+		f32 sinHalf = sqrtf(1.0f - w * w);
+		Vec3f axis = sinHalf > 0.001f ? Vec3f((f32)q[0].ToFloat(), (f32)q[1].ToFloat(), (f32)q[2].ToFloat()) * (1.0f / sinHalf) : Vec3f(1.0f, 0.0f, 0.0f);
+		world *= Matrixf::MakeRotation(2.0f * acosf(w), axis);
+	}
+
+	PvsNode node;
+	node.name = jsonNode.HasKey("name") ? jsonNode["name"].ToString() : TempPrint("node%d", nodeId);
+	node.parent = parent;
+	node.boundsMin = Vec3f(1e30f, 1e30f, 1e30f);
+	node.boundsMax = Vec3f(-1e30f, -1e30f, -1e30f);
+
+	if (jsonNode.HasKey("mesh")) {
+		JsonValue& jsonPrimitive = gltf["meshes"][jsonNode["mesh"].ToInt()]["primitives"][0];
+		Vec3f* pPositions = (Vec3f*)accessors[jsonPrimitive["attributes"]["POSITION"].ToInt()].pBuffer;
+		GltfAccessor& indexAccessor = accessors[jsonPrimitive["indices"].ToInt()];
+		u16* pIndices = (u16*)indexAccessor.pBuffer;
+		for (i32 i = 0; i < indexAccessor.count; i++) {
+			Vec3f p = pPositions[pIndices[i]];
+			Vec4f worldPos = world * Vec4f(p.x, p.y, p.z, 1.0f);
+			Vec3f pos = Vec3f(worldPos.x, worldPos.y, worldPos.z);
+			triangles.PushBack(pos);
+			node.boundsMin = Vec3f(min(node.boundsMin.x, pos.x), min(node.boundsMin.y, pos.y), min(node.boundsMin.z, pos.z));
+			node.boundsMax = Vec3f(max(node.boundsMax.x, pos.x), max(node.boundsMax.y, pos.y), max(node.boundsMax.z, pos.z));
+		}
+	}
+
+	nodes.PushBack(node);
+	i32 index = (i32)nodes.count - 1;
+
+	if (jsonNode.HasKey("children")) {
+		i32 childCount = jsonNode["children"].Count();
+		for (i32 i = 0; i < childCount; i++) {
+			CollectPvsNodes(gltf, accessors, jsonNode["children"][i].ToInt(), index, world, nodes, triangles);
+		}
+	}
+}
+
+// ***********************************************************************
+
+i32 GetPvsCell(PvsGrid& grid, Vec3f pos) {
+	i32 x = (i32)floorf((pos.x - grid.origin.x) / grid.cellSize);
+	i32 y = (i32)floorf((pos.y - grid.origin.y) / grid.cellSize);
+	i32 z = (i32)floorf((pos.z - grid.origin.z) / grid.cellSize);
+	if (x < 0 || y < 0 || z < 0 || x >= grid.dims[0] || y >= grid.dims[1] || z >= grid.dims[2])
+		return -1;
+	return x + grid.dims[0] * (y + grid.dims[1] * z);
+}
+
+// ***********************************************************************
+
+bool IsInsideBounds(Vec3f pos, Vec3f boundsMin, Vec3f boundsMax) {
+	return pos.x >= boundsMin.x && pos.y >= boundsMin.y && pos.z >= boundsMin.z
+		&& pos.x <= boundsMax.x && pos.y <= boundsMax.y && pos.z <= boundsMax.z;
+}
+
+// ***********************************************************************
+
+enum class EPvsCellState : u8 {
+	Unknown,
+	Seen,
+	Hidden
+};
+
+// ***********************************************************************
+
+// Walks the cells on the line between the centres of two cells. Empty cells passed on the way are marked
+// seen, the target is marked either way. Only cells before the target block, so solid targets can be seen
+bool PvsTraceCells(PvsGrid& grid, i32* pFrom, i32* pTo, EPvsCellState* pStates) {
+	i32 pos[3];
+	i32 step[3];
+	i32 length[3];
+	i32 taken[3] = { 0, 0, 0 };
+	for (i32 axis = 0; axis < 3; axis++) {
+		pos[axis] = pFrom[axis];
+		step[axis] = pTo[axis] >= pFrom[axis] ? 1 : -1;
+		length[axis] = abs(pTo[axis] - pFrom[axis]);
+	}
+	i32 target = pTo[0] + grid.dims[0] * (pTo[1] + grid.dims[1] * pTo[2]);
+
+	while (true) {
+		// the next boundary along an axis is at (2 * taken + 1) / (2 * length), compared without dividing
+		i32 next = -1;
+		for (i32 axis = 0; axis < 3; axis++) {
+			if (taken[axis] == length[axis])
+				continue;
+			if (next < 0 || (2 * taken[axis] + 1) * length[next] < (2 * taken[next] + 1) * length[axis])
+				next = axis;
+		}
+		if (next < 0)
+			break;
+
+		// step every axis crossing at the same point together, so corners are passed straight through
+		i32 nextTaken = taken[next];
+		i32 nextLength = length[next];
+		for (i32 axis = 0; axis < 3; axis++) {
+			if (taken[axis] < length[axis] && (2 * taken[axis] + 1) * nextLength == (2 * nextTaken + 1) * length[axis]) {
+				pos[axis] += step[axis];
+				taken[axis]++;
+			}
+		}
+
+		i32 cell = pos[0] + grid.dims[0] * (pos[1] + grid.dims[1] * pos[2]);
+		if (cell == target)
+			break;
+		if (grid.pSolid[cell]) {
+			pStates[target] = EPvsCellState::Hidden;
+			return false;
+		}
+		pStates[cell] = EPvsCellState::Seen;
+	}
+	pStates[target] = EPvsCellState::Seen;
+	return true;
+}
+
+// ***********************************************************************
+
+void ComputePvs(Arena* pArena, lua_State* L, JsonValue& gltf, ResizableArray<GltfAccessor>& accessors, ImportOptions& options) {
+	ResizableArray<PvsNode> nodes(pArena);
+	ResizableArray<Vec3f> triangles(pArena);
+	JsonValue& topLevelNodeList = gltf["scenes"][0]["nodes"];
+	for (i32 i = 0; i < topLevelNodeList.Count(); i++) {
+		CollectPvsNodes(gltf, accessors, topLevelNodeList[i].ToInt(), -1, Matrixf::Identity(), nodes, triangles);
+	}
+	if (triangles.count < 3) {
+		Log::Warn("	Scene has no geometry, skipping visibility computation");
+		return;
+	}
+
+	// children always come after their parents, so walking backwards grows parents to cover their whole subtree
+	for (i64 i = nodes.count - 1; i >= 0; i--) {
+		i32 parent = nodes[i].parent;
+		if (parent < 0)
+			continue;
+		PvsNode& p = nodes[parent];
+		p.boundsMin = Vec3f(min(p.boundsMin.x, nodes[i].boundsMin.x), min(p.boundsMin.y, nodes[i].boundsMin.y), min(p.boundsMin.z, nodes[i].boundsMin.z));
+		p.boundsMax = Vec3f(max(p.boundsMax.x, nodes[i].boundsMax.x), max(p.boundsMax.y, nodes[i].boundsMax.y), max(p.boundsMax.z, nodes[i].boundsMax.z));
+	}
+
+	// grid covering the scene with a cell of padding all round
+	Vec3f sceneMin = triangles[0];
+	Vec3f sceneMax = triangles[0];
+	for (i64 i = 0; i < triangles.count; i++) {
+		sceneMin = Vec3f(min(sceneMin.x, triangles[i].x), min(sceneMin.y, triangles[i].y), min(sceneMin.z, triangles[i].z));
+		sceneMax = Vec3f(max(sceneMax.x, triangles[i].x), max(sceneMax.y, triangles[i].y), max(sceneMax.z, triangles[i].z));
+	}
+	Vec3f extent = sceneMax - sceneMin;
+	f32 largestAxis = max(extent.x, max(extent.y, extent.z));
+	f32 minCellSize = largestAxis / (PVS_MAX_CELLS_PER_AXIS - 2);
+	if (options.pvsCellSize > 0.0f && options.pvsCellSize < minCellSize)
+		Log::Warn("	PVS cell size %f would make too big a grid, using %f", options.pvsCellSize, minCellSize);
+
+	PvsGrid grid;
+	grid.cellSize = max(max(options.pvsCellSize, minCellSize), 0.0001f);
+	grid.origin = sceneMin - Vec3f(grid.cellSize, grid.cellSize, grid.cellSize);
+	grid.dims[0] = (i32)ceilf(extent.x / grid.cellSize) + 2;
+	grid.dims[1] = (i32)ceilf(extent.y / grid.cellSize) + 2;
+	grid.dims[2] = (i32)ceilf(extent.z / grid.cellSize) + 2;
+	i32 cellCount = grid.dims[0] * grid.dims[1] * grid.dims[2];
+	grid.pSolid = New(pArena, bool, cellCount);
+	memset(grid.pSolid, 0, cellCount * sizeof(bool));
+
+	// mark every cell a triangle touches, sampling it finer than the grid
+	for (i64 t = 0; t + 2 < triangles.count; t += 3) {
+		Vec3f p0 = triangles[t];
+		Vec3f e1 = triangles[t + 1] - p0;
+		Vec3f e2 = triangles[t + 2] - p0;
+		Vec3f e3 = triangles[t + 2] - triangles[t + 1];
+		f32 longestEdge = sqrtf(max(Vec3f::Dot(e1, e1), max(Vec3f::Dot(e2, e2), Vec3f::Dot(e3, e3))));
+		i32 n = max((i32)ceilf(longestEdge / (grid.cellSize * 0.5f)), 1);
+		for (i32 i = 0; i <= n; i++) {
+			for (i32 j = 0; j <= n - i; j++) {
+				i32 cell = GetPvsCell(grid, p0 + e1 * ((f32)i / n) + e2 * ((f32)j / n));
+				if (cell >= 0)
+					grid.pSolid[cell] = true;
+			}
+		}
+	}
+
+	// targets sit inside each node's bounds shrunk by half a cell, thin axes are left alone
+	ResizableArray<Vec3f> targetMins(pArena);
+	ResizableArray<Vec3f> targetMaxs(pArena);
+	for (i64 i = 0; i < nodes.count; i++) {
+		Vec3f lo = nodes[i].boundsMin;
+		Vec3f hi = nodes[i].boundsMax;
+		f32 shrink = grid.cellSize * 0.5f;
+		for (i32 axis = 0; axis < 3; axis++) {
+			f32* pLo = &lo.x + axis;
+			f32* pHi = &hi.x + axis;
+			if (*pHi - *pLo > grid.cellSize) {
+				*pLo += shrink;
+				*pHi -= shrink;
+			}
+		}
+		targetMins.PushBack(lo);
+		targetMaxs.PushBack(hi);
+	}
+
+	// and the cells those targets cover, empty where a node has no geometry under it
+	i32* pTargetCells = New(pArena, i32, nodes.count * 6);
+	for (i64 i = 0; i < nodes.count; i++) {
+		i32* pBox = pTargetCells + i * 6;
+		for (i32 axis = 0; axis < 3; axis++) {
+			f32 lo = (&targetMins[i].x)[axis];
+			f32 hi = (&targetMaxs[i].x)[axis];
+			f32 origin = (&grid.origin.x)[axis];
+			pBox[axis] = clamp((i32)floorf((lo - origin) / grid.cellSize), 0, grid.dims[axis] - 1);
+			pBox[axis + 3] = clamp((i32)floorf((hi - origin) / grid.cellSize), 0, grid.dims[axis] - 1);
+		}
+	}
+
+	i32 wordsPerRow = ((i32)nodes.count + 31) / 32;
+	ResizableArray<u32> rows(pArena);
+	i32 rowCount = 0;
+	HashMap<u64, i32> rowLookup; // row index + 1, so 0 is missing
+	rowLookup.pArena = pArena;
+	i32* pCellRows = New(pArena, i32, cellCount);
+	u32* pRow = New(pArena, u32, wordsPerRow);
+	EPvsCellState* pStates = New(pArena, EPvsCellState, cellCount);
+
+	i32 viewerCells = 0;
+	for (i32 z = 0; z < grid.dims[2]; z++) {
+		// big scenes take a while, so say how far along we are
+		Log::Info("	PVS: %d%%", z * 100 / grid.dims[2]);
+
+		for (i32 y = 0; y < grid.dims[1]; y++) {
+			for (i32 x = 0; x < grid.dims[0]; x++) {
+				i32 cell = x + grid.dims[0] * (y + grid.dims[1] * z);
+				Vec3f viewer = grid.origin + Vec3f(x + 0.5f, y + 0.5f, z + 0.5f) * grid.cellSize;
+
+				// only cells a camera could be in, anywhere else the runtime treats everything as visible
+				bool insideScene = false;
+				for (i64 i = 0; i < nodes.count && !insideScene; i++) {
+					insideScene = nodes[i].parent < 0 && IsInsideBounds(viewer, nodes[i].boundsMin, nodes[i].boundsMax);
+				}
+				if (grid.pSolid[cell] || !insideScene) {
+					pCellRows[cell] = -1;
+					continue;
+				}
+				viewerCells++;
+
+				// what this cell can see is worked out lazily, and shared by every node covering the same cells
+				memset(pStates, 0, cellCount * sizeof(EPvsCellState));
+				memset(pRow, 0, wordsPerRow * sizeof(u32));
+				i32 viewerPos[3] = { x, y, z };
+				for (i32 n = 0; n < nodes.count; n++) {
+					Vec3f lo = targetMins[n];
+					Vec3f hi = targetMaxs[n];
+					i32* pBox = pTargetCells + n * 6;
+
+					// nodes without geometry anywhere under them can't be culled
+					bool visible = lo.x > hi.x || IsInsideBounds(viewer, lo, hi);
+
+					// cells already seen on the way to other nodes are free, only trace if none of them were
+					for (i32 tz = pBox[2]; tz <= pBox[5] && !visible; tz++) {
+						for (i32 ty = pBox[1]; ty <= pBox[4] && !visible; ty++) {
+							for (i32 tx = pBox[0]; tx <= pBox[3] && !visible; tx++) {
+								visible = pStates[tx + grid.dims[0] * (ty + grid.dims[1] * tz)] == EPvsCellState::Seen;
+							}
+						}
+					}
+					for (i32 tz = pBox[2]; tz <= pBox[5] && !visible; tz++) {
+						for (i32 ty = pBox[1]; ty <= pBox[4] && !visible; ty++) {
+							for (i32 tx = pBox[0]; tx <= pBox[3] && !visible; tx++) {
+								if (pStates[tx + grid.dims[0] * (ty + grid.dims[1] * tz)] != EPvsCellState::Unknown)
+									continue;
+								i32 targetPos[3] = { tx, ty, tz };
+								visible = PvsTraceCells(grid, viewerPos, targetPos, pStates);
+							}
+						}
+					}
+					if (visible)
+						pRow[n / 32] |= 1u << (n % 32);
+				}
+
+				// neighbouring cells mostly see the same things, so rows are shared
+				u64 hash = HashBytes(14695981039346656037ull, pRow, wordsPerRow * sizeof(u32));
+				i32& lookup = rowLookup[hash];
+				i32 rowIndex = lookup - 1;
+				if (rowIndex < 0 || memcmp(&rows[rowIndex * wordsPerRow], pRow, wordsPerRow * sizeof(u32)) != 0) {
+					// a collision just costs a duplicate row, the first one keeps the slot
+					if (rowIndex < 0)
+						lookup = rowCount + 1;
+					rowIndex = rowCount++;
+					for (i32 w = 0; w < wordsPerRow; w++) rows.PushBack(pRow[w]);
+				}
+				pCellRows[cell] = rowIndex;
+			}
+		}
+	}
+
+	// -------------------------------------
+	// Push pvs table
+
+	lua_newtable(L);
+
+	UserData* pOrigin = AllocUserData(L, Type::Float32, 3, 1);
+	memcpy(pOrigin->pData, &grid.origin, sizeof(Vec3f));
+	lua_setfield(L, -2, "origin");
+	lua_pushnumber(L, grid.cellSize);
+	lua_setfield(L, -2, "cell_size");
+	lua_pushnumber(L, grid.dims[0]);
+	lua_setfield(L, -2, "width");
+	lua_pushnumber(L, grid.dims[1]);
+	lua_setfield(L, -2, "height");
+	lua_pushnumber(L, grid.dims[2]);
+	lua_setfield(L, -2, "depth");
+	lua_pushnumber(L, wordsPerRow);
+	lua_setfield(L, -2, "words_per_row");
+
+	// names in bit order
+	lua_newtable(L);
+	for (i32 i = 0; i < nodes.count; i++) {
+		lua_pushlstring(L, nodes[i].name.pData, nodes[i].name.length);
+		lua_rawseti(L, -2, i + 1);
+	}
+	lua_setfield(L, -2, "nodes");
+
+	UserData* pCells = AllocUserData(L, Type::Int32, cellCount, 1);
+	memcpy(pCells->pData, pCellRows, cellCount * sizeof(i32));
+	lua_setfield(L, -2, "cells");
+
+	UserData* pRows = AllocUserData(L, Type::Int32, max((i32)rows.count, 1), 1);
+	memcpy(pRows->pData, rows.pData, rows.count * sizeof(u32));
+	lua_setfield(L, -2, "rows");
+
+	lua_setfield(L, -2, "pvs");
+
+	Log::Info("	PVS: %dx%dx%d cells, %d viewer cells, %d nodes, %d unique sets", grid.dims[0], grid.dims[1], grid.dims[2], viewerCells, (i32)nodes.count, rowCount);
+}
+
+// ***********************************************************************
+
+bool ImportGltf(Arena* pArena, lua_State* L, u8 format, String source, ImportOptions options) {
 	// Load file
 	String fileContents;
     fileContents.pData = ReadWholeFile(source, &fileContents.length, pArena);
@@ -372,6 +1106,15 @@ bool ImportGltf(Arena* pArena, lua_State* L, u8 format, String source) {
 		i32 nIndices = accessors[jsonPrimitive["indices"].ToInt()].count;
 		u16* indexBuffer = (u16*)accessors[jsonPrimitive["indices"].ToInt()].pBuffer;
 
+		// before flattening, so lods and the full mesh share the same bake
+		if (options.bakeLighting) {
+			if (vertNormBuffer == nullptr)
+				Log::Warn("Mesh %S has no normals, baked lighting will be flat", meshName);
+			BakeVertexLighting(pArena, indexedVertexData, indexBuffer, nIndices, options);
+			lua_pushboolean(L, true);
+			lua_setfield(L, -2, "baked_lighting");
+		}
+
 		ResizableArray<VertexData> vertices(pArena);
 		vertices.Reserve(nIndices);
 		for (int i = 0; i < nIndices; i++) {
@@ -386,6 +1129,41 @@ bool ImportGltf(Arena* pArena, lua_State* L, u8 format, String source) {
 		memcpy((u8*)pUserData->pData, (u8*)vertices.pData, bufSize);
 		lua_setfield(L, -2, "vertices");
 
+		// bounding radius around the mesh origin, used at runtime to estimate screen size for lod selection
+		f32 radiusSq = 0.0f;
+		for (int i = 0; i < nVerts; i++) {
+			radiusSq = max(radiusSq, Vec3f::Dot(indexedVertexData[i].pos, indexedVertexData[i].pos));
+		}
+		lua_pushnumber(L, sqrtf(radiusSq));
+		lua_setfield(L, -2, "radius");
+
+		// generate simplified lods, each roughly half the triangles of the last
+		lua_newtable(L);
+		if (nVerts > 0 && nIndices >= 3) {
+			Simplifier simp;
+			InitSimplifier(pArena, simp, indexedVertexData, indexBuffer, nIndices);
+
+			i32 lodCount = 0;
+			i32 prevTriangles = simp.triangleCount;
+			for (i32 lod = 0; lod < MAX_MESH_LODS; lod++) {
+				i32 target = prevTriangles / 2;
+				if (target < MIN_LOD_TRIANGLES)
+					break;
+
+				SimplifyToTarget(pArena, simp, target);
+
+				// not worth keeping a lod that barely changed anything, further ones won't do better
+				if (simp.triangleCount > prevTriangles * 9 / 10)
+					break;
+
+				PushSimplifiedVertices(L, simp, indexedVertexData);
+				lua_rawseti(L, -2, ++lodCount);
+				prevTriangles = simp.triangleCount;
+			}
+			Log::Info("	Mesh %S: %d triangles, generated %d lods", meshName, nIndices / 3, lodCount);
+		}
+		lua_setfield(L, -2, "lods");
+
 		lua_setfield(L, -2, meshName.pData);
 	}
 
@@ -463,11 +1241,64 @@ bool ImportGltf(Arena* pArena, lua_State* L, u8 format, String source) {
 
 	lua_setfield(L, -2, "textures"); // set textures table into top level table
 
+	if (options.computePvs) {
+		ComputePvs(pArena, L, parsed, accessors, options);
+	}
+
+	return true;
+}
+
+// ***********************************************************************
+
+bool ParseOptionVec3(String value, Vec3f& out) {
+	// copy so strtof has a terminator to stop at
+	String terminated = TempPrint("%S", value);
+	char* pCursor = terminated.pData;
+	f32 components[3];
+	for (i32 i = 0; i < 3; i++) {
+		char* pEnd;
+		components[i] = strtof(pCursor, &pEnd);
+		if (pEnd == pCursor)
+			return false;
+		pCursor = *pEnd == ',' ? pEnd + 1 : pEnd;
+	}
+	out = Vec3f(components[0], components[1], components[2]);
 	return true;
 }
 
 // ***********************************************************************
 
+void ParseImportOption(String option, ImportOptions& options) {
+	i64 equals = Find(option, "=");
+	String key = equals >= 0 ? SubStr(option, 0, equals) : option;
+	String value = equals >= 0 ? SubStr(option, equals + 1) : String();
+
+	bool valid = true;
+	if (key == "bake_lighting")
+		options.bakeLighting = true;
+	else if (key == "light")
+		valid = ParseOptionVec3(value, options.lightDirection);
+	else if (key == "light_color")
+		valid = ParseOptionVec3(value, options.lightColor);
+	else if (key == "ambient")
+		valid = ParseOptionVec3(value, options.ambient);
+	else if (key == "pvs")
+		options.computePvs = true;
+	else if (key == "pvs_cell") {
+		String terminated = TempPrint("%S", value);
+		char* pEnd;
+		options.pvsCellSize = strtof(terminated.pData, &pEnd);
+		valid = pEnd != terminated.pData && options.pvsCellSize > 0.0f;
+	}
+	else
+		valid = false;
+
+	if (!valid)
+		Log::Warn("Unknown or malformed import option %S", option);
+}
+
+// ***********************************************************************
+
 AssetImportTable* LoadImportTable(String project) {
 	// create a new one if this project has no import table
 	String importTablePath = TempPrint("system/%S/import_table.txt", project);
@@ -525,14 +1356,27 @@ AssetImportTable* LoadImportTable(String project) {
 			String lastWriteTimeStr = SubStr(fileContents, start, i-start);
 			u64 lastWriteTime = strtoull(lastWriteTimeStr.pData, nullptr, 10); 
 
-			i++; // advance over end of number, and then advance to start of next asset
+			// anything else on the line is import options
+			ImportOptions options;
+			while (i<fileContents.length && fileContents[i] != '\n' && fileContents[i] != '"') {
+				if (Scan::IsWhitespace(fileContents[i])) {
+					i++;
+					continue;
+				}
+				start = i;
+				while (i<fileContents.length && !Scan::IsWhitespace(fileContents[i])) i++;
+				ParseImportOption(SubStr(fileContents, start, i-start), options);
+			}
+
+			// advance to start of next asset
 			while (fileContents[i] != '"' && i<fileContents.length) i++;
 
 			pImportTable->table[sourceAsset] = ImportTableAsset{ 
 				.outputPath = outputPath,
 				.enableAutoImport = autoImport,
 				.lastImportTime = lastWriteTime,
-				.importFormat = importFormat
+				.importFormat = importFormat,
+				.options = options
 			};
 		}
 		else {
@@ -550,7 +1394,21 @@ bool SaveImportTable(AssetImportTable* pTable, String project) {
 	for (i64 i = 0; i < pTable->table.tableSize; i++) {
 		HashNode<String, ImportTableAsset>& node = pTable->table.pTable[i];
 		if (node.hash != UNUSED_HASH) {
-			builder.AppendFormat("\"%S\" \"%S\" %d %s %llu\n", node.key, node.value.outputPath, node.value.importFormat, node.value.enableAutoImport ? "1" : "0", node.value.lastImportTime);
+			builder.AppendFormat("\"%S\" \"%S\" %d %s %llu", node.key, node.value.outputPath, node.value.importFormat, node.value.enableAutoImport ? "1" : "0", node.value.lastImportTime);
+
+			ImportOptions& options = node.value.options;
+			if (options.bakeLighting) {
+				builder.AppendFormat(" bake_lighting light=%f,%f,%f light_color=%f,%f,%f ambient=%f,%f,%f",
+					options.lightDirection.x, options.lightDirection.y, options.lightDirection.z,
+					options.lightColor.x, options.lightColor.y, options.lightColor.z,
+					options.ambient.x, options.ambient.y, options.ambient.z);
+			}
+			if (options.computePvs) {
+				builder.Append(" pvs");
+				if (options.pvsCellSize > 0.0f)
+					builder.AppendFormat(" pvs_cell=%f", options.pvsCellSize);
+			}
+			builder.Append("\n");
 		}
 	}
 	String importTablePath = TempPrint("system/%S/import_table.txt", project);
@@ -561,7 +1419,7 @@ bool SaveImportTable(AssetImportTable* pTable, String project) {
 
 // ***********************************************************************
 
-int ImportFile(Arena* pScratchArena, u8 format, String source, String output) {
+int ImportFile(Arena* pScratchArena, u8 format, String source, String output, ImportOptions options) {
 
 	NormalizePath(source);
 	NormalizePath(output);
@@ -586,7 +1444,7 @@ int ImportFile(Arena* pScratchArena, u8 format, String source, String output) {
 		// Actually do the import, depending on the file type
 		String extension = TakeAfterLastDot(source);
 		if (extension == "gltf") {
-			if (!ImportGltf(pScratchArena, L, format, source)) {
+			if (!ImportGltf(pScratchArena, L, format, source, options)) {
 				return -1;
 			} 
 		}
@@ -4,11 +4,27 @@ struct Arena;
 
 namespace AssetImporter {
 
+// Per asset options, written after the other fields of an import table line, i.e.
+// "source.gltf" "project/output.scene" 3 1 1338 bake_lighting light=-1,1,0 ambient=0.4,0.4,0.4
+struct ImportOptions {
+	// bakes light 0, ambient and ambient occlusion into the vertex colours, in mesh space
+	bool bakeLighting { false };
+	Vec3f lightDirection { Vec3f(-1.0f, 1.0f, 0.0f) };
+	Vec3f lightColor { Vec3f(1.0f, 1.0f, 1.0f) };
+	Vec3f ambient { Vec3f(0.4f, 0.4f, 0.4f) };
+
+	// computes a potentially visible set between scene nodes, for visible_nodes to query.
+	// a cell size of zero picks one from the scene size
+	bool computePvs { false };
+	f32 pvsCellSize { 0.0f };
+};
+
 struct ImportTableAsset {
 	String outputPath;
 	bool enableAutoImport;
 	u64 lastImportTime;
 	u8 importFormat;
+	ImportOptions options;
 };
 
 struct AssetImportTable {
@@ -18,8 +34,8 @@ struct AssetImportTable {
 
 AssetImportTable* LoadImportTable(String project);
 
-bool ImportGltf(Arena* pArena, lua_State* L, u8 format, String source);
+bool ImportGltf(Arena* pArena, lua_State* L, u8 format, String source, ImportOptions options);
 
-int ImportFile(Arena* pScratchArena, u8 format, String source, String output);
+int ImportFile(Arena* pScratchArena, u8 format, String source, String output, ImportOptions options);
 
 };
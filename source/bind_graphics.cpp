@@ -52,11 +52,37 @@ int LuaBeginObject3D(lua_State* pLua) {
         type = EPrimitiveType::Points;
     else if (strcmp(primitiveType, "Triangles") == 0)
         type = EPrimitiveType::Triangles;
+    else if (strcmp(primitiveType, "TriangleStrip") == 0)
+        type = EPrimitiveType::TriangleStrip;
     else if (strcmp(primitiveType, "Lines") == 0)
         type = EPrimitiveType::Lines;
     else if (strcmp(primitiveType, "LineStrip") == 0)
         type = EPrimitiveType::LineStrip;
     BeginObject3D(type);
+
+    // optional index buffer, indices are relative to the vertices of this object
+    if (!lua_isnoneornil(pLua, 2)) {
+        UserData* pIndices = (UserData*)luaL_checkudata(pLua, 2, "UserData");
+        i32 count = pIndices->width * pIndices->height;
+        if (pIndices->type == Type::Int16) {
+            Indices((u16*)pIndices->pData, count);
+        }
+        else if (pIndices->type == Type::Int32) {
+            u32* pData = (u32*)pIndices->pData;
+            u16* pNarrowed = New(g_pArenaFrame, u16, count);
+            for (i32 i = 0; i < count; i++) {
+                if (pData[i] > 0xFFFF) {
+                    luaL_error(pLua, "Index %u is too large, objects are limited to 65536 vertices", pData[i]);
+                    return 0;
+                }
+                pNarrowed[i] = (u16)pData[i];
+            }
+            Indices(pNarrowed, count);
+        }
+        else {
+            luaL_error(pLua, "Index buffers must be i16 or i32 userdata");
+        }
+    }
     return 0;
 }
 
@@ -107,6 +133,22 @@ int LuaSetCullMode(lua_State* pLua) {
 
 // ***********************************************************************
 
+int LuaVertexFormat(lua_State* pLua) {
+    const char* vertexFormat = luaL_checkstring(pLua, 1);
+    EVertexFormat format;
+    if (strcmp(vertexFormat, "Standard") == 0)
+        format = EVertexFormat::Standard;
+    else if (strcmp(vertexFormat, "Packed") == 0)
+        format = EVertexFormat::Packed;
+    else {
+        luaL_error(pLua, "Invalid vertex format %s, expected Standard or Packed", vertexFormat);
+        return 0;
+    }
+    VertexFormat(format);
+    return 0;
+}
+// ***********************************************************************
+
 int LuaSetClearColor(lua_State* pLua) {
     f32 r = (f32)luaL_checknumber(pLua, 1);
     f32 g = (f32)luaL_checknumber(pLua, 2);
@@ -165,7 +207,16 @@ int LuaLoadMatrix(lua_State* pLua) {
 int LuaGetMatrix(lua_State* pLua) {
     Matrixf mat = GetMatrix();
 
-	UserData* pUserData = AllocUserData(pLua, Type::Float32, 4, 4);
+	// can be given a userdata to fill rather than making a new one every call
+	UserData* pUserData;
+	if (lua_isnoneornil(pLua, 1)) {
+		pUserData = AllocUserData(pLua, Type::Float32, 4, 4);
+	} else {
+		pUserData = (UserData*)luaL_checkudata(pLua, 1, "UserData");
+		if (pUserData->type != Type::Float32 || pUserData->width * pUserData->height < 16)
+			luaL_error(pLua, "get_matrix destination must be f32 userdata with at least 16 elements");
+		lua_pushvalue(pLua, 1);
+	}
 	memcpy((u8*)pUserData->pData, mat.m, 16*sizeof(f32));
     return 1;
 }
@@ -238,6 +289,71 @@ int LuaUnbindTexture(lua_State* pLua) {
 
 // ***********************************************************************
 
+struct TextureArray {
+	sg_image image;
+	i32 width;
+	i32 height;
+	i32 layers;
+};
+
+void DestroyTextureArrayUserData(void* pData) {
+	DestroyTextureArray(((TextureArray*)pData)->image);
+}
+
+// ***********************************************************************
+
+int LuaNewTextureArray(lua_State* pLua) {
+	luaL_checktype(pLua, 1, LUA_TTABLE);
+	i32 layerCount = (i32)lua_objlen(pLua, 1);
+	if (layerCount <= 0 || layerCount > MAX_TEXTURES) {
+		luaL_error(pLua, "Texture arrays must have between 1 and %d layers", MAX_TEXTURES);
+		return 0;
+	}
+
+	u8* pixels[MAX_TEXTURES];
+	i32 width = 0;
+	i32 height = 0;
+	for (i32 i = 0; i < layerCount; i++) {
+		lua_rawgeti(pLua, 1, i + 1);
+		UserData* pUserData = (UserData*)luaL_checkudata(pLua, -1, "UserData");
+		if (pUserData->type != Type::Int32)
+			luaL_error(pLua, "Texture array layers must be i32 image userdata");
+		if (i == 0) {
+			width = pUserData->width;
+			height = pUserData->height;
+		}
+		else if (pUserData->width != width || pUserData->height != height) {
+			luaL_error(pLua, "Texture array layers must all be the same size, layer %d is %dx%d, expected %dx%d", i + 1, pUserData->width, pUserData->height, width, height);
+		}
+		pixels[i] = pUserData->pData;
+		lua_pop(pLua, 1);
+	}
+
+	TextureArray* pArray = (TextureArray*)lua_newuserdatadtor(pLua, sizeof(TextureArray), DestroyTextureArrayUserData);
+	pArray->image = CreateTextureArray(pixels, layerCount, width, height);
+	pArray->width = width;
+	pArray->height = height;
+	pArray->layers = layerCount;
+	luaL_getmetatable(pLua, "TextureArray");
+	lua_setmetatable(pLua, -2);
+	return 1;
+}
+
+// ***********************************************************************
+
+int LuaBindTextureArray(lua_State* pLua) {
+	TextureArray* pArray = (TextureArray*)luaL_checkudata(pLua, 1, "TextureArray");
+	i32 layer = (i32)luaL_checkinteger(pLua, 2);
+	if (layer < 0 || layer >= pArray->layers) {
+		luaL_error(pLua, "Layer %d is out of range, array has %d layers", layer, pArray->layers);
+		return 0;
+	}
+	BindTextureArray(pArray->image, layer);
+	return 0;
+}
+
+// ***********************************************************************
+
 int LuaNormalsMode(lua_State* pLua) {
     const char* normalsMode = luaL_checkstring(pLua, 1);
     ENormalsMode mode;
@@ -253,6 +369,19 @@ int LuaNormalsMode(lua_State* pLua) {
 
 // ***********************************************************************
 
+// Writes face normals into a vertex buffer in the imported mesh layout, so meshes that
+// don't change can do this once and then draw in Custom normals mode
+int LuaComputeFlatNormals(lua_State* pLua) {
+	UserData* pVertices = (UserData*)luaL_checkudata(pLua, 1, "UserData");
+	if (pVertices->type != Type::Float32)
+		luaL_error(pLua, "Vertices must be f32 userdata");
+	i64 count = GetUserDataSize(pVertices) / sizeof(VertexData);
+	ComputeFlatNormals((VertexData*)pVertices->pData, count);
+	return 0;
+}
+
+// ***********************************************************************
+
 int LuaEnableLighting(lua_State* pLua) {
 	luaL_checktype(pLua, -1, LUA_TBOOLEAN);
     bool enabled = lua_toboolean(pLua, -1) != 0;
@@ -303,6 +432,203 @@ int LuaEnableFog(lua_State* pLua) {
 
 // ***********************************************************************
 
+int LuaEnableDynamicResolution(lua_State* pLua) {
+	luaL_checktype(pLua, 1, LUA_TBOOLEAN);
+	bool enabled = lua_toboolean(pLua, 1) != 0;
+	// budget is in seconds, like the rest of the timing api
+	f32 frameBudget = (f32)luaL_optnumber(pLua, 2, 1.0 / 60.0);
+	if (frameBudget <= 0.0f) {
+		luaL_error(pLua, "Frame budget must be greater than zero");
+		return 0;
+	}
+	EnableDynamicResolution(enabled, frameBudget);
+	return 0;
+}
+
+// ***********************************************************************
+
+int LuaEnableDither(lua_State* pLua) {
+	luaL_checktype(pLua, -1, LUA_TBOOLEAN);
+    bool enabled = lua_toboolean(pLua, -1) != 0; 
+    EnableDither(enabled);
+    return 0;
+}
+
+// ***********************************************************************
+
+int LuaSetDitherPattern(lua_State* pLua) {
+    const char* patternName = luaL_checkstring(pLua, 1);
+    EDitherPattern pattern;
+    if (strcmp(patternName, "Bayer2") == 0)
+        pattern = EDitherPattern::Bayer2;
+    else if (strcmp(patternName, "Bayer4") == 0)
+        pattern = EDitherPattern::Bayer4;
+    else if (strcmp(patternName, "Bayer8") == 0)
+        pattern = EDitherPattern::Bayer8;
+    else
+        luaL_error(pLua, "Unknown dither pattern %s, expected Bayer2, Bayer4 or Bayer8", patternName);
+    SetDitherPattern(pattern);
+    return 0;
+}
+
+// ***********************************************************************
+
+int LuaGetVram(lua_State* pLua) {
+	AllocUserDataView(pLua, Type::Int16, VRAM_WIDTH, VRAM_HEIGHT, (u8*)Vram::GetPixels());
+	return 1;
+}
+
+// ***********************************************************************
+
+int LuaVramUpload(lua_State* pLua) {
+	i32 x = (i32)luaL_checkinteger(pLua, 1);
+	i32 y = (i32)luaL_checkinteger(pLua, 2);
+	UserData* pSource = (UserData*)luaL_checkudata(pLua, 3, "UserData");
+	if (pSource->type != Type::Int16) {
+		luaL_error(pLua, "vram_upload expects i16 userdata, one value per vram pixel");
+		return 0;
+	}
+
+	// clip to vram
+	i32 minX = max(x, 0);
+	i32 minY = max(y, 0);
+	i32 maxX = min(x + pSource->width, VRAM_WIDTH);
+	i32 maxY = min(y + pSource->height, VRAM_HEIGHT);
+	if (minX >= maxX || minY >= maxY)
+		return 0;
+
+	u16* pVram = Vram::GetPixels();
+	u16* pPixels = (u16*)pSource->pData;
+	for (i32 row = minY; row < maxY; row++) {
+		memcpy(pVram + row * VRAM_WIDTH + minX, pPixels + (row - y) * pSource->width + (minX - x), (maxX - minX) * sizeof(u16));
+	}
+	Vram::MarkDirty(minX, minY, maxX - minX, maxY - minY);
+	return 0;
+}
+
+// ***********************************************************************
+
+int LuaVramMarkDirty(lua_State* pLua) {
+	i32 x = (i32)luaL_checkinteger(pLua, 1);
+	i32 y = (i32)luaL_checkinteger(pLua, 2);
+	i32 width = (i32)luaL_checkinteger(pLua, 3);
+	i32 height = (i32)luaL_checkinteger(pLua, 4);
+	Vram::MarkDirty(x, y, width, height);
+	return 0;
+}
+
+// ***********************************************************************
+
+int LuaBindVramPage(lua_State* pLua) {
+	Vec2f page;
+	page.x = (f32)luaL_checknumber(pLua, 1);
+	page.y = (f32)luaL_checknumber(pLua, 2);
+	const char* modeName = luaL_checkstring(pLua, 3);
+
+	EVramMode mode;
+	if (strcmp(modeName, "Clut4") == 0)
+		mode = EVramMode::Clut4;
+	else if (strcmp(modeName, "Clut8") == 0)
+		mode = EVramMode::Clut8;
+	else if (strcmp(modeName, "Direct15") == 0)
+		mode = EVramMode::Direct15;
+	else
+		luaL_error(pLua, "Unknown vram mode %s, expected Clut4, Clut8 or Direct15", modeName);
+
+	Vec2f clut;
+	clut.x = (f32)luaL_optnumber(pLua, 4, 0.0);
+	clut.y = (f32)luaL_optnumber(pLua, 5, 0.0);
+	BindVramPage(page, mode, clut);
+	return 0;
+}
+
+// ***********************************************************************
+
+int LuaSubmitPackets(lua_State* pLua) {
+	UserData* pPackets = (UserData*)luaL_checkudata(pLua, 1, "UserData");
+	i32 count = (i32)luaL_checkinteger(pLua, 2);
+	if (pPackets->type != Type::Int32 && pPackets->type != Type::Uint8) {
+		luaL_error(pLua, "submit_packets expects i32 or u8 userdata");
+		return 0;
+	}
+
+	String error;
+	if (!SubmitPackets((u32*)pPackets->pData, GetUserDataSize(pPackets) / sizeof(u32), count, &error)) {
+		luaL_error(pLua, "Invalid packet buffer: %s", error.pData);
+	}
+	return 0;
+}
+
+// ***********************************************************************
+
+int LuaNewShader(lua_State* pLua) {
+	size_t length;
+	const char* pSource = luaL_checklstring(pLua, 1, &length);
+
+	String error;
+	i32 shader = CreateUserShader(CopyCStringRange((char*)pSource, (char*)pSource + length, g_pArenaFrame), &error);
+	if (shader < 0) {
+		luaL_error(pLua, "Shader failed to compile: %s", error.pData);
+		return 0;
+	}
+
+	i32* pShader = (i32*)lua_newuserdata(pLua, sizeof(i32));
+	*pShader = shader;
+	luaL_getmetatable(pLua, "Shader");
+	lua_setmetatable(pLua, -2);
+	return 1;
+}
+
+// ***********************************************************************
+
+int LuaSetShader(lua_State* pLua) {
+	if (lua_isnoneornil(pLua, 1)) {
+		SetShader(-1);
+		return 0;
+	}
+	i32* pShader = (i32*)luaL_checkudata(pLua, 1, "Shader");
+	SetShader(*pShader);
+	return 0;
+}
+
+// ***********************************************************************
+
+int LuaSetShaderParam(lua_State* pLua) {
+	i32 index = (i32)luaL_checkinteger(pLua, 1);
+	if (index < 0 || index >= MAX_SHADER_PARAMS) {
+		luaL_error(pLua, "Shader param index %d out of range, expected 0 to %d", index, MAX_SHADER_PARAMS - 1);
+		return 0;
+	}
+
+	Vec4f value;
+	value.x = (f32)luaL_checknumber(pLua, 2);
+	value.y = (f32)luaL_optnumber(pLua, 3, 0.0);
+	value.z = (f32)luaL_optnumber(pLua, 4, 0.0);
+	value.w = (f32)luaL_optnumber(pLua, 5, 0.0);
+	SetShaderParam(index, value);
+	return 0;
+}
+
+// ***********************************************************************
+
+int LuaEnableOcclusionCulling(lua_State* pLua) {
+	luaL_checktype(pLua, -1, LUA_TBOOLEAN);
+    bool enabled = lua_toboolean(pLua, -1) != 0; 
+    EnableOcclusionCulling(enabled);
+    return 0;
+}
+
+// ***********************************************************************
+
+int LuaSetOccluder(lua_State* pLua) {
+	luaL_checktype(pLua, -1, LUA_TBOOLEAN);
+    bool enabled = lua_toboolean(pLua, -1) != 0; 
+    Occluder(enabled);
+    return 0;
+}
+
+// ***********************************************************************
+
 int LuaSetFogStart(lua_State* pLua) {
     f32 start = (f32)luaL_checknumber(pLua, 1);
     SetFogStart(start);
@@ -342,6 +668,35 @@ int LuaDrawSprite(lua_State* pLua) {
 
 // ***********************************************************************
 
+int LuaDrawMap(lua_State* pLua) {
+	UserData* pTiles = (UserData*)luaL_checkudata(pLua, 1, "UserData");
+	UserData* pTileset = (UserData*)luaL_checkudata(pLua, 2, "UserData");
+	if (pTiles->type != Type::Int16 && pTiles->type != Type::Uint8) {
+		luaL_error(pLua, "draw_map expects i16 or u8 tile userdata");
+		return 0;
+	}
+	UpdateUserDataImage(pTileset);
+
+	i32 cellX = (i32)luaL_checkinteger(pLua, 3);
+	i32 cellY = (i32)luaL_checkinteger(pLua, 4);
+	i32 width = (i32)luaL_checkinteger(pLua, 5);
+	i32 height = (i32)luaL_checkinteger(pLua, 6);
+	Vec2f position;
+	position.x = (f32)luaL_checknumber(pLua, 7);
+	position.y = (f32)luaL_checknumber(pLua, 8);
+	i32 tileSize = (i32)luaL_optinteger(pLua, 9, 8);
+	if (tileSize <= 0) {
+		luaL_error(pLua, "draw_map tile size must be positive");
+		return 0;
+	}
+
+	Vec2f tilesetSize = Vec2f((f32)pTileset->width, (f32)pTileset->height);
+	DrawMap(pTiles->pData, pTiles->type == Type::Int16, pTiles->width, pTiles->height, pTileset->img, tilesetSize, tileSize, cellX, cellY, width, height, position);
+	return 0;
+}
+
+// ***********************************************************************
+
 int LuaDrawSpriteRect(lua_State* pLua) {
 	UserData* pUserData = (UserData*)luaL_checkudata(pLua, 1, "UserData");
 	UpdateUserDataImage(pUserData);
@@ -359,6 +714,687 @@ int LuaDrawSpriteRect(lua_State* pLua) {
 
 // ***********************************************************************
 
+int LuaSelectLod(lua_State* pLua) {
+	luaL_checktype(pLua, 1, LUA_TTABLE);
+
+	// meshes imported before lods existed just have vertices, so fall back to those
+	lua_getfield(pLua, 1, "radius");
+	lua_getfield(pLua, 1, "lods");
+	if (lua_isnumber(pLua, -2) && lua_istable(pLua, -1)) {
+		f32 radius = (f32)lua_tonumber(pLua, -2);
+		i32 lodCount = lua_objlen(pLua, -1);
+
+		i32 lod = SelectLod(radius, lodCount);
+		if (lod > 0) {
+			lua_rawgeti(pLua, -1, lod);
+			return 1;
+		}
+	}
+	lua_getfield(pLua, 1, "vertices");
+	return 1;
+}
+
+// ***********************************************************************
+
+i32 GetPvsNumber(lua_State* pLua, i32 pvsIndex, const char* field) {
+	lua_getfield(pLua, pvsIndex, field);
+	i32 value = (i32)lua_tointeger(pLua, -1);
+	lua_pop(pLua, 1);
+	return value;
+}
+
+// ***********************************************************************
+
+// Set of node names that might be seen from a position, using the pvs computed at import.
+// Anywhere the pvs doesn't cover, such as outside the level, gets every node
+int LuaVisibleNodes(lua_State* pLua) {
+	luaL_checktype(pLua, 1, LUA_TTABLE);
+	UserData* pPos = (UserData*)luaL_checkudata(pLua, 2, "UserData");
+	if (pPos->type != Type::Float32 || GetUserDataSize(pPos) < 3 * (i64)sizeof(f32))
+		luaL_error(pLua, "Camera position must be a vector with 3 components");
+
+	lua_getfield(pLua, 1, "pvs");
+	if (!lua_istable(pLua, -1))
+		luaL_error(pLua, "Scene has no pvs, import it with the pvs option");
+	i32 pvsIndex = lua_absindex(pLua, -1);
+
+	i32 width = GetPvsNumber(pLua, pvsIndex, "width");
+	i32 height = GetPvsNumber(pLua, pvsIndex, "height");
+	i32 depth = GetPvsNumber(pLua, pvsIndex, "depth");
+	i32 wordsPerRow = GetPvsNumber(pLua, pvsIndex, "words_per_row");
+	lua_getfield(pLua, pvsIndex, "cell_size");
+	f32 cellSize = (f32)lua_tonumber(pLua, -1);
+	lua_getfield(pLua, pvsIndex, "origin");
+	lua_getfield(pLua, pvsIndex, "cells");
+	lua_getfield(pLua, pvsIndex, "rows");
+	lua_getfield(pLua, pvsIndex, "nodes");
+	UserData* pOrigin = (UserData*)luaL_checkudata(pLua, -4, "UserData");
+	UserData* pCells = (UserData*)luaL_checkudata(pLua, -3, "UserData");
+	UserData* pRows = (UserData*)luaL_checkudata(pLua, -2, "UserData");
+	i32 namesIndex = lua_absindex(pLua, -1);
+	i32 nodeCount = lua_objlen(pLua, namesIndex);
+
+	f32* pOriginData = (f32*)pOrigin->pData;
+	f32* pPosData = (f32*)pPos->pData;
+	i32 x = (i32)floorf((pPosData[0] - pOriginData[0]) / cellSize);
+	i32 y = (i32)floorf((pPosData[1] - pOriginData[1]) / cellSize);
+	i32 z = (i32)floorf((pPosData[2] - pOriginData[2]) / cellSize);
+
+	u32* pRow = nullptr;
+	if (x >= 0 && y >= 0 && z >= 0 && x < width && y < height && z < depth) {
+		i32 cell = x + width * (y + height * z);
+		i32 rowIndex = ((i32*)pCells->pData)[cell];
+		if (rowIndex >= 0 && (rowIndex + 1) * wordsPerRow * (i64)sizeof(u32) <= GetUserDataSize(pRows))
+			pRow = (u32*)pRows->pData + rowIndex * wordsPerRow;
+	}
+
+	lua_createtable(pLua, 0, nodeCount);
+	for (i32 i = 0; i < nodeCount; i++) {
+		if (pRow && (pRow[i / 32] & (1u << (i % 32))) == 0)
+			continue;
+		lua_rawgeti(pLua, namesIndex, i + 1);
+		lua_pushboolean(pLua, true);
+		lua_rawset(pLua, -3);
+	}
+	return 1;
+}
+
+// ***********************************************************************
+
+struct StaticScene {
+	i32 meshCount;
+	StaticMesh* pMeshes;
+	i32 textureArrayCount;
+	sg_image* pTextureArrays;
+};
+
+// batches sample either a scene texture, looked up again at draw time, or one of the scene's own texture arrays
+struct StaticBatch {
+	UserData* pTexture;
+	sg_image textureArray;
+	ResizableArray<VertexData> vertices;
+};
+
+// where a scene texture ended up when same sized textures are stacked into arrays
+struct StaticTextureLayer {
+	UserData* pTexture;
+	sg_image textureArray;
+	i32 layer;
+};
+
+// ***********************************************************************
+
+// Keeps the value at valueIndex alive for as long as the holder at holderIndex is, for
+// native objects that keep pointers to lua values
+void KeepAlive(lua_State* pLua, i32 holderIndex, i32 valueIndex) {
+	holderIndex = lua_absindex(pLua, holderIndex);
+	valueIndex = lua_absindex(pLua, valueIndex);
+	lua_getfield(pLua, LUA_REGISTRYINDEX, "_KEEPALIVE");
+	lua_pushvalue(pLua, holderIndex);
+	lua_pushvalue(pLua, valueIndex);
+	lua_rawset(pLua, -3);
+	lua_pop(pLua, 1);
+}
+
+// ***********************************************************************
+
+UserData* GetNodeUserData(lua_State* pLua, i32 nodeIndex, const char* field) {
+	lua_getfield(pLua, nodeIndex, field);
+	UserData* pUserData = lua_type(pLua, -1) == LUA_TUSERDATA ? (UserData*)lua_touserdata(pLua, -1) : nullptr;
+	lua_pop(pLua, 1); // the node table keeps it alive
+	if (pUserData && pUserData->type != Type::Float32)
+		return nullptr;
+	return pUserData;
+}
+
+// ***********************************************************************
+
+void BakeStaticNodes(lua_State* pLua, i32 nodesIndex, i32 meshesIndex, i32 texturesIndex, i32 usedTexturesIndex, i32 filterIndex, Matrixf parent, ResizableArray<StaticTextureLayer>& layers, ResizableArray<StaticBatch>& batches) {
+	lua_pushnil(pLua);
+	while (lua_next(pLua, nodesIndex) != 0) {
+		// key at -2, node at -1
+		i32 nodeIndex = lua_absindex(pLua, -1);
+		if (!lua_istable(pLua, nodeIndex)) {
+			lua_pop(pLua, 1);
+			continue;
+		}
+
+		// same transform order as the scripts use, translate, scale, then rotate
+		Matrixf world = parent;
+		if (UserData* pPos = GetNodeUserData(pLua, nodeIndex, "position")) {
+			f32* p = (f32*)pPos->pData;
+			world *= Matrixf::MakeTranslation(Vec3f(p[0], p[1], p[2]));
+		}
+		if (UserData* pScale = GetNodeUserData(pLua, nodeIndex, "scale")) {
+			f32* s = (f32*)pScale->pData;
+			world *= Matrixf::MakeScale(Vec3f(s[0], s[1], s[2]));
+		}
+		if (UserData* pRot = GetNodeUserData(pLua, nodeIndex, "rotation")) {
+			f32* q = (f32*)pRot->pData;
+			f32 w = clamp(q[3], -1.0f, 1.0f);
+			f32 sinHalf = sqrtf(1.0f - w * w);
+			Vec3f axis = sinHalf > 0.001f ? Vec3f(q[0], q[1], q[2]) * (1.0f / sinHalf) : Vec3f(1.0f, 0.0f, 0.0f);
+			world *= Matrixf::MakeRotation(2.0f * acosf(w), axis);
+		}
+
+		bool isStatic = true;
+		if (filterIndex != 0) {
+			lua_pushvalue(pLua, filterIndex);
+			lua_pushvalue(pLua, -3); // name
+			lua_pushvalue(pLua, nodeIndex);
+			lua_call(pLua, 2, 1);
+			isStatic = lua_toboolean(pLua, -1) != 0;
+			lua_pop(pLua, 1);
+		}
+
+		lua_getfield(pLua, nodeIndex, "mesh");
+		if (isStatic && lua_isstring(pLua, -1)) {
+			lua_gettable(pLua, meshesIndex);
+			if (lua_istable(pLua, -1)) {
+				UserData* pVertices = GetNodeUserData(pLua, lua_absindex(pLua, -1), "vertices");
+
+				// find the texture this mesh uses, meshes with no texture share an untextured batch
+				UserData* pTexture = nullptr;
+				sg_image textureArray = { SG_INVALID_ID };
+				f32 layerOffset = 0.0f;
+				lua_getfield(pLua, -1, "texture");
+				if (lua_isstring(pLua, -1)) {
+					lua_gettable(pLua, texturesIndex);
+					if (lua_istable(pLua, -1)) {
+						lua_getfield(pLua, -1, "data");
+						if (lua_type(pLua, -1) == LUA_TUSERDATA) {
+							pTexture = (UserData*)lua_touserdata(pLua, -1);
+
+							// stacked textures batch by array, with the layer in the uvs
+							for (i32 i = 0; i < layers.count; i++) {
+								if (layers[i].pTexture == pTexture) {
+									textureArray = layers[i].textureArray;
+									layerOffset = layers[i].layer * TEXTURE_ARRAY_LAYER_STRIDE;
+									pTexture = nullptr;
+									break;
+								}
+							}
+
+							// the scene's meshes will point at it, so it has to outlive them
+							if (pTexture) {
+								lua_pushvalue(pLua, -1);
+								lua_pushboolean(pLua, true);
+								lua_rawset(pLua, usedTexturesIndex);
+							}
+						}
+						lua_pop(pLua, 1);
+					}
+				}
+				lua_pop(pLua, 1);
+
+				if (pVertices) {
+					StaticBatch* pBatch = nullptr;
+					for (i32 i = 0; i < batches.count; i++) {
+						if (batches[i].pTexture == pTexture && batches[i].textureArray.id == textureArray.id) {
+							pBatch = &batches[i];
+							break;
+						}
+					}
+					if (pBatch == nullptr) {
+						StaticBatch batch;
+						batch.pTexture = pTexture;
+						batch.textureArray = textureArray;
+						batch.vertices.pArena = g_pArenaFrame;
+						batches.PushBack(batch);
+						pBatch = &batches[batches.count - 1];
+					}
+
+					VertexData* pSrc = (VertexData*)pVertices->pData;
+					i32 count = (i32)(GetUserDataSize(pVertices) / sizeof(VertexData));
+					pBatch->vertices.Reserve(pBatch->vertices.count + count);
+					for (i32 i = 0; i < count; i++) {
+						VertexData v = pSrc[i];
+						Vec4f pos = world * Vec4f(v.pos.x, v.pos.y, v.pos.z, 1.0f);
+						Vec4f norm = world * Vec4f(v.norm.x, v.norm.y, v.norm.z, 0.0f);
+						v.pos = Vec3f(pos.x, pos.y, pos.z);
+						v.norm = Vec3f(norm.x, norm.y, norm.z).GetNormalized();
+						v.tex.x += layerOffset;
+						pBatch->vertices.PushBack(v);
+					}
+				}
+			}
+		}
+		lua_pop(pLua, 1);
+
+		lua_getfield(pLua, nodeIndex, "children");
+		if (lua_istable(pLua, -1)) {
+			BakeStaticNodes(pLua, lua_absindex(pLua, -1), meshesIndex, texturesIndex, usedTexturesIndex, filterIndex, world, layers, batches);
+		}
+		lua_pop(pLua, 2); // children and node
+	}
+}
+
+// ***********************************************************************
+
+void DestroyStaticScene(void* pData) {
+	StaticScene* pScene = (StaticScene*)pData;
+	for (i32 i = 0; i < pScene->meshCount; i++) {
+		DestroyStaticMesh(pScene->pMeshes[i]);
+	}
+	for (i32 i = 0; i < pScene->textureArrayCount; i++) {
+		DestroyTextureArray(pScene->pTextureArrays[i]);
+	}
+}
+
+// ***********************************************************************
+
+// Stacks the scene's textures into arrays by size, so meshes with different textures
+// can share a batch. Textures with no others of their size are left alone
+void BuildStaticTextureArrays(lua_State* pLua, i32 texturesIndex, ResizableArray<StaticTextureLayer>& layers, ResizableArray<sg_image>& textureArrays) {
+	ResizableArray<UserData*> textures(g_pArenaFrame);
+	lua_pushnil(pLua);
+	while (lua_next(pLua, texturesIndex) != 0) {
+		if (lua_istable(pLua, -1)) {
+			lua_getfield(pLua, -1, "data");
+			if (lua_type(pLua, -1) == LUA_TUSERDATA) {
+				UserData* pTexture = (UserData*)luaL_checkudata(pLua, -1, "UserData");
+				if (pTexture->type == Type::Int32)
+					textures.PushBack(pTexture);
+			}
+			lua_pop(pLua, 1);
+		}
+		lua_pop(pLua, 1);
+	}
+
+	ResizableArray<bool> used(g_pArenaFrame);
+	for (i64 i = 0; i < textures.count; i++) used.PushBack(false);
+
+	for (i64 i = 0; i < textures.count; i++) {
+		if (used[i])
+			continue;
+
+		// gather up to MAX_TEXTURES of this size
+		UserData* group[MAX_TEXTURES];
+		u8* pixels[MAX_TEXTURES];
+		i32 groupCount = 0;
+		for (i64 j = i; j < textures.count && groupCount < MAX_TEXTURES; j++) {
+			if (used[j] || textures[j]->width != textures[i]->width || textures[j]->height != textures[i]->height)
+				continue;
+			used[j] = true;
+			group[groupCount] = textures[j];
+			pixels[groupCount] = textures[j]->pData;
+			groupCount++;
+		}
+		if (groupCount < 2)
+			continue;
+
+		sg_image textureArray = CreateTextureArray(pixels, groupCount, textures[i]->width, textures[i]->height);
+		textureArrays.PushBack(textureArray);
+		for (i32 layer = 0; layer < groupCount; layer++) {
+			layers.PushBack({ group[layer], textureArray, layer });
+		}
+	}
+}
+
+// ***********************************************************************
+
+int LuaBakeStatic(lua_State* pLua) {
+	luaL_checktype(pLua, 1, LUA_TTABLE);
+	i32 filterIndex = 0;
+	if (!lua_isnoneornil(pLua, 2)) {
+		luaL_checktype(pLua, 2, LUA_TFUNCTION);
+		filterIndex = 2;
+	}
+	bool useTextureArrays = lua_toboolean(pLua, 3) != 0;
+	bool packed = lua_toboolean(pLua, 4) != 0;
+
+	lua_getfield(pLua, 1, "scene");
+	lua_getfield(pLua, 1, "meshes");
+	lua_getfield(pLua, 1, "textures");
+	if (!lua_istable(pLua, -3) || !lua_istable(pLua, -2) || !lua_istable(pLua, -1)) {
+		luaL_error(pLua, "bake_static expects a loaded scene with scene, meshes and textures tables");
+		return 0;
+	}
+	i32 texturesIndex = lua_absindex(pLua, -1);
+	i32 meshesIndex = lua_absindex(pLua, -2);
+	i32 nodesIndex = lua_absindex(pLua, -3);
+
+	ResizableArray<StaticTextureLayer> layers(g_pArenaFrame);
+	ResizableArray<sg_image> textureArrays(g_pArenaFrame);
+	if (useTextureArrays) {
+		BuildStaticTextureArrays(pLua, texturesIndex, layers, textureArrays);
+	}
+
+	lua_newtable(pLua);
+	i32 usedTexturesIndex = lua_absindex(pLua, -1);
+
+	ResizableArray<StaticBatch> batches(g_pArenaFrame);
+	BakeStaticNodes(pLua, nodesIndex, meshesIndex, texturesIndex, usedTexturesIndex, filterIndex, Matrixf::Identity(), layers, batches);
+
+	i64 meshesSize = batches.count * sizeof(StaticMesh);
+	StaticScene* pScene = (StaticScene*)lua_newuserdatadtor(pLua, sizeof(StaticScene) + meshesSize + textureArrays.count * sizeof(sg_image), DestroyStaticScene);
+	pScene->meshCount = (i32)batches.count;
+	pScene->pMeshes = (StaticMesh*)((u8*)pScene + sizeof(StaticScene));
+	for (i32 i = 0; i < batches.count; i++) {
+		// the array layer rides in the integer part of u, which quantising could push into the neighbouring layer
+		bool packBatch = packed && batches[i].textureArray.id == SG_INVALID_ID;
+		pScene->pMeshes[i] = CreateStaticMesh(batches[i].vertices.pData, (i32)batches[i].vertices.count, batches[i].pTexture, batches[i].textureArray, packBatch);
+	}
+	pScene->textureArrayCount = (i32)textureArrays.count;
+	pScene->pTextureArrays = (sg_image*)((u8*)pScene + sizeof(StaticScene) + meshesSize);
+	for (i32 i = 0; i < textureArrays.count; i++) {
+		pScene->pTextureArrays[i] = textureArrays[i];
+	}
+
+	luaL_getmetatable(pLua, "StaticScene");
+	lua_setmetatable(pLua, -2);
+
+	// the script may drop or replace its textures, the scene keeps the ones it uses
+	KeepAlive(pLua, -1, usedTexturesIndex);
+	return 1;
+}
+
+// ***********************************************************************
+
+int LuaDrawStatic(lua_State* pLua) {
+	StaticScene* pScene = (StaticScene*)luaL_checkudata(pLua, 1, "StaticScene");
+	for (i32 i = 0; i < pScene->meshCount; i++) {
+		DrawStaticMesh(pScene->pMeshes[i]);
+	}
+	return 0;
+}
+
+// ***********************************************************************
+
+void DestroyTerrainUserData(void* pData) {
+	DestroyTerrain(*(Terrain*)pData);
+}
+
+// ***********************************************************************
+
+int LuaNewTerrain(lua_State* pLua) {
+	UserData* pHeightmap = (UserData*)luaL_checkudata(pLua, 1, "UserData");
+	f32 cellSize = (f32)luaL_optnumber(pLua, 2, 1.0);
+	f32 heightScale = (f32)luaL_optnumber(pLua, 3, 1.0);
+	f32 textureRepeat = (f32)luaL_optnumber(pLua, 4, 1.0);
+	if (pHeightmap->type != Type::Float32)
+		luaL_error(pLua, "Terrain heightmap must be f32 userdata");
+	if (pHeightmap->width < 2 || pHeightmap->height < 2)
+		luaL_error(pLua, "Terrain heightmap must be at least 2x2, got %dx%d", pHeightmap->width, pHeightmap->height);
+	if (cellSize <= 0.0f)
+		luaL_error(pLua, "Terrain cell size must be greater than zero");
+
+	// chunks are baked now, so later changes to the heightmap don't show up
+	Terrain* pTerrain = (Terrain*)lua_newuserdatadtor(pLua, GetTerrainSize(pHeightmap->width, pHeightmap->height), DestroyTerrainUserData);
+	CreateTerrain(pTerrain, (f32*)pHeightmap->pData, pHeightmap->width, pHeightmap->height, cellSize, heightScale, textureRepeat);
+	luaL_getmetatable(pLua, "Terrain");
+	lua_setmetatable(pLua, -2);
+	return 1;
+}
+
+// ***********************************************************************
+
+int LuaDrawTerrain(lua_State* pLua) {
+	Terrain* pTerrain = (Terrain*)luaL_checkudata(pLua, 1, "Terrain");
+	DrawTerrain(*pTerrain);
+	return 0;
+}
+
+// ***********************************************************************
+
+void DestroyImpostorUserData(void* pData) {
+	DestroyImpostor(*(Impostor*)pData);
+}
+
+// ***********************************************************************
+
+int LuaNewImpostor(lua_State* pLua) {
+	UserData* pVertices = (UserData*)luaL_checkudata(pLua, 1, "UserData");
+	UserData* pTexture = nullptr;
+	if (!lua_isnoneornil(pLua, 2))
+		pTexture = (UserData*)luaL_checkudata(pLua, 2, "UserData");
+	i32 views = (i32)luaL_optinteger(pLua, 3, 8);
+	i32 resolution = (i32)luaL_optinteger(pLua, 4, 64);
+	if (pVertices->type != Type::Float32)
+		luaL_error(pLua, "Impostor vertices must be f32 userdata");
+	i32 count = (i32)(GetUserDataSize(pVertices) / sizeof(VertexData));
+	if (count < 3)
+		luaL_error(pLua, "Impostor needs at least one triangle");
+	if (views < 1 || views > 64)
+		luaL_error(pLua, "Impostor views must be between 1 and 64, got %d", views);
+	if (resolution < 8 || views * resolution > 4096)
+		luaL_error(pLua, "Impostor atlas of %d views at %d pixels is out of range", views, resolution);
+
+	// the pictures are taken on the render thread at the end of this frame, with the lighting set now
+	Impostor* pImpostor = (Impostor*)lua_newuserdatadtor(pLua, sizeof(Impostor), DestroyImpostorUserData);
+	CreateImpostor(pImpostor, (VertexData*)pVertices->pData, count, pTexture, views, resolution);
+	luaL_getmetatable(pLua, "Impostor");
+	lua_setmetatable(pLua, -2);
+
+	// the mesh is drawn up close with the script's texture
+	if (pTexture)
+		KeepAlive(pLua, -1, 2);
+	return 1;
+}
+
+// ***********************************************************************
+
+int LuaDrawImpostor(lua_State* pLua) {
+	Impostor* pImpostor = (Impostor*)luaL_checkudata(pLua, 1, "Impostor");
+	f32 switchDistance = (f32)luaL_optnumber(pLua, 2, -1.0);
+	DrawImpostor(*pImpostor, switchDistance);
+	return 0;
+}
+
+// ***********************************************************************
+
+int LuaNewEmitter(lua_State* pLua) {
+	i32 capacity = (i32)luaL_checkinteger(pLua, 1);
+	bool is3D = lua_toboolean(pLua, 2) != 0;
+	if (capacity <= 0 || capacity > MAX_PARTICLES_PER_EMITTER) {
+		luaL_error(pLua, "Emitter capacity must be between 1 and %d", MAX_PARTICLES_PER_EMITTER);
+		return 0;
+	}
+
+	// the particle arrays live in the userdata, so the gc owns them
+	ParticleEmitter* pEmitter = (ParticleEmitter*)lua_newuserdata(pLua, Particles::GetEmitterSize(capacity));
+	Particles::InitEmitter(pEmitter, capacity, is3D);
+	luaL_getmetatable(pLua, "Emitter");
+	lua_setmetatable(pLua, -2);
+	return 1;
+}
+
+// ***********************************************************************
+
+// Reads an optional settings field that is either vector userdata or an array of numbers,
+// missing components are left as they were
+void GetEmitterSetting(lua_State* pLua, i32 settingsIndex, const char* field, f32* pOut, i32 count) {
+	lua_getfield(pLua, settingsIndex, field);
+	if (lua_type(pLua, -1) == LUA_TUSERDATA) {
+		UserData* pUserData = (UserData*)luaL_checkudata(pLua, -1, "UserData");
+		if (pUserData->type != Type::Float32)
+			luaL_error(pLua, "Emitter setting %s must be f32 userdata", field);
+		i32 available = (i32)min((i64)count, GetUserDataSize(pUserData) / (i64)sizeof(f32));
+		memcpy(pOut, pUserData->pData, available * sizeof(f32));
+	}
+	else if (lua_istable(pLua, -1)) {
+		for (i32 i = 0; i < count; i++) {
+			lua_rawgeti(pLua, -1, i + 1);
+			if (lua_isnumber(pLua, -1))
+				pOut[i] = (f32)lua_tonumber(pLua, -1);
+			lua_pop(pLua, 1);
+		}
+	}
+	else if (lua_isnumber(pLua, -1)) {
+		// a single number sets every component, handy for ranges and uniform spreads
+		for (i32 i = 0; i < count; i++) {
+			pOut[i] = (f32)lua_tonumber(pLua, -1);
+		}
+	}
+	lua_pop(pLua, 1);
+}
+
+// ***********************************************************************
+
+int LuaSetEmitter(lua_State* pLua) {
+	ParticleEmitter* pEmitter = (ParticleEmitter*)luaL_checkudata(pLua, 1, "Emitter");
+	luaL_checktype(pLua, 2, LUA_TTABLE);
+
+	GetEmitterSetting(pLua, 2, "position", &pEmitter->position.x, 3);
+	GetEmitterSetting(pLua, 2, "spread", &pEmitter->positionSpread.x, 3);
+	GetEmitterSetting(pLua, 2, "velocity_min", &pEmitter->velocityMin.x, 3);
+	GetEmitterSetting(pLua, 2, "velocity_max", &pEmitter->velocityMax.x, 3);
+	GetEmitterSetting(pLua, 2, "gravity", &pEmitter->gravity.x, 3);
+	GetEmitterSetting(pLua, 2, "drag", &pEmitter->drag, 1);
+	GetEmitterSetting(pLua, 2, "rate", &pEmitter->rate, 1);
+	GetEmitterSetting(pLua, 2, "start_color", &pEmitter->startColor.x, 4);
+	GetEmitterSetting(pLua, 2, "end_color", &pEmitter->endColor.x, 4);
+
+	f32 life[2] = { pEmitter->lifeMin, pEmitter->lifeMax };
+	GetEmitterSetting(pLua, 2, "life", life, 2);
+	pEmitter->lifeMin = life[0];
+	pEmitter->lifeMax = life[1];
+
+	f32 size[2] = { pEmitter->startSize, pEmitter->endSize };
+	GetEmitterSetting(pLua, 2, "size", size, 2);
+	pEmitter->startSize = size[0];
+	pEmitter->endSize = size[1];
+	return 0;
+}
+
+// ***********************************************************************
+
+int LuaEmitParticles(lua_State* pLua) {
+	ParticleEmitter* pEmitter = (ParticleEmitter*)luaL_checkudata(pLua, 1, "Emitter");
+	Particles::Emit(*pEmitter, (i32)luaL_checkinteger(pLua, 2));
+	return 0;
+}
+
+// ***********************************************************************
+
+int LuaUpdateEmitter(lua_State* pLua) {
+	ParticleEmitter* pEmitter = (ParticleEmitter*)luaL_checkudata(pLua, 1, "Emitter");
+	Particles::Update(*pEmitter, (f32)luaL_checknumber(pLua, 2));
+	return 0;
+}
+
+// ***********************************************************************
+
+int LuaDrawEmitter(lua_State* pLua) {
+	ParticleEmitter* pEmitter = (ParticleEmitter*)luaL_checkudata(pLua, 1, "Emitter");
+	sg_image texture = { SG_INVALID_ID };
+	if (!lua_isnoneornil(pLua, 2)) {
+		UserData* pUserData = (UserData*)luaL_checkudata(pLua, 2, "UserData");
+		UpdateUserDataImage(pUserData);
+		texture = pUserData->img;
+	}
+	DrawParticles(*pEmitter, texture);
+	return 0;
+}
+
+// ***********************************************************************
+
+int LuaEmitterCount(lua_State* pLua) {
+	ParticleEmitter* pEmitter = (ParticleEmitter*)luaL_checkudata(pLua, 1, "Emitter");
+	lua_pushinteger(pLua, pEmitter->count);
+	return 1;
+}
+
+// ***********************************************************************
+
+int LuaGetGpuUsage(lua_State* pLua) {
+	GpuResourceUsage usage = GpuResources::GetUsage();
+
+	lua_newtable(pLua);
+	lua_pushinteger(pLua, usage.images);
+	lua_setfield(pLua, -2, "images");
+	lua_pushinteger(pLua, usage.buffers);
+	lua_setfield(pLua, -2, "buffers");
+	lua_pushnumber(pLua, (f64)usage.imageBytes);
+	lua_setfield(pLua, -2, "image_bytes");
+	lua_pushnumber(pLua, (f64)usage.bufferBytes);
+	lua_setfield(pLua, -2, "buffer_bytes");
+	lua_pushnumber(pLua, (f64)usage.budget);
+	lua_setfield(pLua, -2, "budget");
+	lua_pushinteger(pLua, usage.evictions);
+	lua_setfield(pLua, -2, "evictions");
+	return 1;
+}
+
+// ***********************************************************************
+
+int LuaSetVramBudget(lua_State* pLua) {
+	f64 bytes = luaL_checknumber(pLua, 1);
+	if (bytes < 0) {
+		luaL_error(pLua, "VRAM budget must be positive");
+		return 0;
+	}
+	GpuResources::SetBudget((i64)bytes);
+	return 0;
+}
+
+// ***********************************************************************
+
+int LuaGetRenderStats(lua_State* pLua) {
+	RenderStats stats = GetRenderStats();
+
+	lua_newtable(pLua);
+	lua_pushinteger(pLua, stats.drawCommands);
+	lua_setfield(pLua, -2, "draw_commands");
+	lua_pushinteger(pLua, stats.drawCommands2D);
+	lua_setfield(pLua, -2, "draw_commands_2d");
+	lua_pushinteger(pLua, stats.drawCommands3D);
+	lua_setfield(pLua, -2, "draw_commands_3d");
+	lua_pushinteger(pLua, stats.verticesUploaded);
+	lua_setfield(pLua, -2, "vertices_uploaded");
+	lua_pushinteger(pLua, stats.indicesUploaded);
+	lua_setfield(pLua, -2, "indices_uploaded");
+	lua_pushinteger(pLua, stats.pipelineSwitches);
+	lua_setfield(pLua, -2, "pipeline_switches");
+	lua_pushinteger(pLua, stats.bindingSwitches);
+	lua_setfield(pLua, -2, "binding_switches");
+	lua_pushinteger(pLua, stats.textureUploads);
+	lua_setfield(pLua, -2, "texture_uploads");
+	lua_pushnumber(pLua, (f64)stats.textureUploadBytes);
+	lua_setfield(pLua, -2, "texture_upload_bytes");
+	lua_pushinteger(pLua, stats.vertexBufferOverflows);
+	lua_setfield(pLua, -2, "vertex_buffer_overflows");
+	lua_pushinteger(pLua, stats.occlusionCulled);
+	lua_setfield(pLua, -2, "occlusion_culled");
+	lua_pushinteger(pLua, stats.drawsMerged);
+	lua_setfield(pLua, -2, "draws_merged");
+	lua_pushinteger(pLua, stats.layersReused);
+	lua_setfield(pLua, -2, "layers_reused");
+	lua_pushnumber(pLua, stats.renderTime);
+	lua_setfield(pLua, -2, "render_time");
+	lua_pushnumber(pLua, stats.resolutionScale);
+	lua_setfield(pLua, -2, "resolution_scale");
+	lua_pushboolean(pLua, stats.frameReused);
+	lua_setfield(pLua, -2, "frame_reused");
+
+	// raw backend counters
+	lua_newtable(pLua);
+	lua_pushinteger(pLua, stats.sokol.num_passes);
+	lua_setfield(pLua, -2, "passes");
+	lua_pushinteger(pLua, stats.sokol.num_apply_pipeline);
+	lua_setfield(pLua, -2, "apply_pipeline");
+	lua_pushinteger(pLua, stats.sokol.num_apply_bindings);
+	lua_setfield(pLua, -2, "apply_bindings");
+	lua_pushinteger(pLua, stats.sokol.num_apply_uniforms);
+	lua_setfield(pLua, -2, "apply_uniforms");
+	lua_pushinteger(pLua, stats.sokol.num_draw);
+	lua_setfield(pLua, -2, "draw");
+	lua_pushinteger(pLua, stats.sokol.num_update_buffer);
+	lua_setfield(pLua, -2, "update_buffer");
+	lua_pushinteger(pLua, stats.sokol.num_update_image);
+	lua_setfield(pLua, -2, "update_image");
+	lua_pushinteger(pLua, stats.sokol.size_apply_uniforms);
+	lua_setfield(pLua, -2, "size_apply_uniforms");
+	lua_pushinteger(pLua, stats.sokol.size_update_buffer);
+	lua_setfield(pLua, -2, "size_update_buffer");
+	lua_pushinteger(pLua, stats.sokol.size_update_image);
+	lua_setfield(pLua, -2, "size_update_image");
+	lua_setfield(pLua, -2, "sokol");
+	return 1;
+}
+
+// ***********************************************************************
+
 int BindGraphics(lua_State* pLua) {
 
     // Global functions
@@ -374,6 +1410,7 @@ int BindGraphics(lua_State* pLua) {
         { "texcoord", LuaTexCoord },
         { "normal", LuaNormal },
         { "set_cull_mode", LuaSetCullMode },
+        { "vertex_format", LuaVertexFormat },
         { "set_clear_color", LuaSetClearColor },
         { "matrix_mode", LuaMatrixMode },
         { "push_matrix", LuaPushMatrix },
@@ -387,16 +1424,50 @@ int BindGraphics(lua_State* pLua) {
         { "identity", LuaIdentity },
         { "bind_texture", LuaBindTexture },
         { "unbind_texture", LuaUnbindTexture },
+        { "new_texture_array", LuaNewTextureArray },
+        { "bind_texture_array", LuaBindTextureArray },
         { "normals_mode", LuaNormalsMode },
+        { "compute_flat_normals", LuaComputeFlatNormals },
         { "enable_lighting", LuaEnableLighting },
         { "light", LuaLight },
         { "ambient", LuaAmbient },
         { "enable_fog", LuaEnableFog },
+        { "enable_dither", LuaEnableDither },
+        { "set_dither_pattern", LuaSetDitherPattern },
+        { "get_vram", LuaGetVram },
+        { "vram_upload", LuaVramUpload },
+        { "vram_mark_dirty", LuaVramMarkDirty },
+        { "bind_vram_page", LuaBindVramPage },
+        { "submit_packets", LuaSubmitPackets },
+        { "new_shader", LuaNewShader },
+        { "set_shader", LuaSetShader },
+        { "set_shader_param", LuaSetShaderParam },
+        { "enable_occlusion_culling", LuaEnableOcclusionCulling },
+        { "enable_dynamic_resolution", LuaEnableDynamicResolution },
+        { "set_occluder", LuaSetOccluder },
         { "set_fog_start", LuaSetFogStart },
         { "set_fog_end", LuaSetFogEnd },
         { "set_fog_color", LuaSetFogColor },
         { "draw_sprite", LuaDrawSprite },
         { "draw_sprite_rect", LuaDrawSpriteRect },
+        { "draw_map", LuaDrawMap },
+        { "select_lod", LuaSelectLod },
+        { "visible_nodes", LuaVisibleNodes },
+        { "bake_static", LuaBakeStatic },
+        { "draw_static", LuaDrawStatic },
+        { "new_terrain", LuaNewTerrain },
+        { "draw_terrain", LuaDrawTerrain },
+        { "new_impostor", LuaNewImpostor },
+        { "draw_impostor", LuaDrawImpostor },
+        { "new_emitter", LuaNewEmitter },
+        { "set_emitter", LuaSetEmitter },
+        { "emit_particles", LuaEmitParticles },
+        { "update_emitter", LuaUpdateEmitter },
+        { "draw_emitter", LuaDrawEmitter },
+        { "emitter_count", LuaEmitterCount },
+        { "get_render_stats", LuaGetRenderStats },
+        { "get_gpu_usage", LuaGetGpuUsage },
+        { "set_vram_budget", LuaSetVramBudget },
         { NULL, NULL }
     };
 
@@ -404,6 +1475,38 @@ int BindGraphics(lua_State* pLua) {
     luaL_register(pLua, NULL, graphicsFuncs);
     lua_pop(pLua, 1);
 
+	// lua values kept alive by native objects that point at them, see KeepAlive. Weak keys so the objects themselves can still be collected
+	lua_newtable(pLua);
+	lua_newtable(pLua);
+	lua_pushstring(pLua, "k");
+	lua_setfield(pLua, -2, "__mode");
+	lua_setmetatable(pLua, -2);
+	lua_setfield(pLua, LUA_REGISTRYINDEX, "_KEEPALIVE");
+
+	// opaque handle type for baked static geometry
+	luaL_newmetatable(pLua, "StaticScene");
+	lua_pop(pLua, 1);
+
+	// same sized images stacked into one texture, so draws using different layers can batch
+	luaL_newmetatable(pLua, "TextureArray");
+	lua_pop(pLua, 1);
+
+	// opaque handle type for compiled user shaders, these live for the whole program
+	luaL_newmetatable(pLua, "Shader");
+	lua_pop(pLua, 1);
+
+	// heightmap terrain, chunk buffers are freed with it
+	luaL_newmetatable(pLua, "Terrain");
+	lua_pop(pLua, 1);
+
+	// mesh plus its atlas of pictures, all freed with it
+	luaL_newmetatable(pLua, "Impostor");
+	lua_pop(pLua, 1);
+
+	// particle emitters, the particles themselves live in the userdata
+	luaL_newmetatable(pLua, "Emitter");
+	lua_pop(pLua, 1);
+
     return 0;
 }
 }
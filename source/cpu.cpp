@@ -37,6 +37,20 @@ declare class UserData
 	function __mul(self, other: UserData): UserData
 	function __div(self, other: UserData): UserData
 
+	-- in place on self, or into out when given, returning whichever was written
+	function add(self, other: UserData, out: UserData?): UserData
+	function sub(self, other: UserData, out: UserData?): UserData
+	function mul(self, other: UserData, out: UserData?): UserData
+	function div(self, other: UserData, out: UserData?): UserData
+	function add_sat(self, other: UserData, out: UserData?): UserData
+	function sub_sat(self, other: UserData, out: UserData?): UserData
+	function add_scalar(self, scalar: number, out: UserData?): UserData
+	function sub_scalar(self, scalar: number, out: UserData?): UserData
+	function mul_scalar(self, scalar: number, out: UserData?): UserData
+	function div_scalar(self, scalar: number, out: UserData?): UserData
+	function add_sat_scalar(self, scalar: number, out: UserData?): UserData
+	function sub_sat_scalar(self, scalar: number, out: UserData?): UserData
+
 	x: number
 	y: number
 	z: number
@@ -50,24 +64,26 @@ end
 @checked declare function userdata(type: string, width: number, heightOrDataStr: number|string?, dataStr: string?): UserData
 @checked declare function vec(x: number, y: number, z: number): UserData
 @checked declare function quat(x: number, y: number, z: number, w: number): UserData
+@checked declare function userdata_allocations(): number
 
 --- Graphics API
 
 @checked declare function begin_object_2d(primitiveType: string)
 @checked declare function end_object_2d(primitiveType: string)
 @checked declare function vertex(x: number, y: number, z: number?)
-@checked declare function begin_object_3d(primitiveType: string)
+@checked declare function begin_object_3d(primitiveType: string, indices: UserData?)
 @checked declare function end_object_3d()
 @checked declare function color(r: number, g: number, b: number, a: number)
 @checked declare function texcoord(u: number, v: number)
 @checked declare function normal(x: number, y: number, z: number)
 @checked declare function set_cull_mode(mode: number)
+@checked declare function vertex_format(format: string)
 @checked declare function set_clear_color(r: number, g: number, b: number, a: number)
 @checked declare function matrix_mode(mode: string)
 @checked declare function push_matrix()
 @checked declare function pop_matrix()
 @checked declare function load_matrix(mat: UserData)
-@checked declare function get_matrix(): UserData
+@checked declare function get_matrix(out: UserData?): UserData
 @checked declare function perspective(screenWidth: number, screenHeight: number, nearPlane: number, farPlane: number, fov: number)
 @checked declare function translate(x: number, y: number, z: number)
 @checked declare function rotate(angle: number, x: number, y: number, z: number)
@@ -75,16 +91,121 @@ end
 @checked declare function identity()
 @checked declare function bind_texture(textureData: UserData)
 @checked declare function unbind_texture()
+declare class TextureArray end
+@checked declare function new_texture_array(images: {UserData}): TextureArray
+@checked declare function bind_texture_array(textureArray: TextureArray, layer: number)
+@checked declare function get_vram(): UserData
+@checked declare function vram_upload(x: number, y: number, source: UserData)
+@checked declare function vram_mark_dirty(x: number, y: number, width: number, height: number)
+@checked declare function bind_vram_page(x: number, y: number, mode: string, clutX: number?, clutY: number?)
+@checked declare function submit_packets(packets: UserData, count: number)
 @checked declare function normals_mode(mode: string)
+@checked declare function compute_flat_normals(vertices: UserData)
 @checked declare function enable_lighting(enable: boolean)
 @checked declare function light(id: number, dirX: number, dixY: number, dirZ: number, r: number, g: number, b: number)
 @checked declare function ambient(r: number, g: number, b: number)
 @checked declare function enable_fog(enable: boolean)
+@checked declare function enable_dither(enable: boolean)
+@checked declare function set_dither_pattern(pattern: string)
+@checked declare function enable_occlusion_culling(enable: boolean)
+@checked declare function enable_dynamic_resolution(enable: boolean, frameBudget: number?)
+@checked declare function set_occluder(enable: boolean)
 @checked declare function set_fog_start(fogStart: number)
 @checked declare function set_fog_end(fogEnd: number)
 @checked declare function set_fog_color(r: number, g: number, b: number)
 @checked declare function draw_sprite(spriteData: UserData, x: number, y: number)
 @checked declare function draw_sprite_rect(spriteData: UserData, x: number, y: number, z: number, w: number, posX: number, posY: number)
+@checked declare function draw_map(tiles: UserData, tileset: UserData, cellX: number, cellY: number, width: number, height: number, posX: number, posY: number, tileSize: number?)
+@checked declare function select_lod(mesh: any): UserData
+@checked declare function visible_nodes(scene: any, cameraPos: UserData): {[string]: boolean}
+
+declare class StaticScene end
+
+@checked declare function bake_static(scene: any, isStatic: ((name: string, node: any) -> boolean)?, useTextureArrays: boolean?, packed: boolean?): StaticScene
+@checked declare function draw_static(staticScene: StaticScene)
+declare class Terrain end
+@checked declare function new_terrain(heightmap: UserData, cellSize: number?, heightScale: number?, textureRepeat: number?): Terrain
+@checked declare function draw_terrain(terrain: Terrain)
+declare class Impostor end
+@checked declare function new_impostor(vertices: UserData, texture: UserData?, views: number?, resolution: number?): Impostor
+@checked declare function draw_impostor(impostor: Impostor, switchDistance: number?)
+
+declare class Shader end
+
+@checked declare function new_shader(source: string): Shader
+@checked declare function set_shader(shader: Shader?)
+@checked declare function set_shader_param(index: number, x: number, y: number?, z: number?, w: number?)
+
+declare class Emitter end
+
+type EmitterVec = UserData | {number} | number
+type EmitterSettings = {
+	position: EmitterVec?,
+	spread: EmitterVec?,
+	velocity_min: EmitterVec?,
+	velocity_max: EmitterVec?,
+	gravity: EmitterVec?,
+	drag: number?,
+	rate: number?,
+	life: EmitterVec?,
+	start_color: EmitterVec?,
+	end_color: EmitterVec?,
+	size: EmitterVec?,
+}
+
+@checked declare function new_emitter(capacity: number, is3D: boolean?): Emitter
+@checked declare function set_emitter(emitter: Emitter, settings: EmitterSettings)
+@checked declare function emit_particles(emitter: Emitter, count: number)
+@checked declare function update_emitter(emitter: Emitter, deltaTime: number)
+@checked declare function draw_emitter(emitter: Emitter, texture: UserData?)
+@checked declare function emitter_count(emitter: Emitter): number
+
+declare class SokolFrameStats
+	passes: number
+	apply_pipeline: number
+	apply_bindings: number
+	apply_uniforms: number
+	draw: number
+	update_buffer: number
+	update_image: number
+	size_apply_uniforms: number
+	size_update_buffer: number
+	size_update_image: number
+end
+
+declare class RenderStats
+	draw_commands: number
+	draw_commands_2d: number
+	draw_commands_3d: number
+	vertices_uploaded: number
+	indices_uploaded: number
+	pipeline_switches: number
+	binding_switches: number
+	texture_uploads: number
+	texture_upload_bytes: number
+	vertex_buffer_overflows: number
+	occlusion_culled: number
+	draws_merged: number
+	layers_reused: number
+	render_time: number
+	resolution_scale: number
+	frame_reused: boolean
+	sokol: SokolFrameStats
+end
+
+@checked declare function get_render_stats(): RenderStats
+
+declare class GpuUsage
+	images: number
+	buffers: number
+	image_bytes: number
+	buffer_bytes: number
+	budget: number
+	evictions: number
+end
+
+@checked declare function get_gpu_usage(): GpuUsage
+@checked declare function set_vram_budget(bytes: number)
 
 --- Input API
 
@@ -401,7 +522,7 @@ void OnFileChanged(FileChange change, void* pUserData) {
 				AssetImporter::ImportTableAsset& asset = pState->pImportTable->table[change.path];
 
 				// reimport the asset, leaving it loaded into lua (i.e. we don't serialize it)
-				if (AssetImporter::ImportGltf(g_pArenaFrame, L, asset.importFormat, change.path)) {
+				if (AssetImporter::ImportGltf(g_pArenaFrame, L, asset.importFormat, change.path, asset.options)) {
 					// you want to lookup the asset in the ASSET table
 					i32 newAssetIndex = lua_gettop(L);
 					luaL_findtable(L, LUA_REGISTRYINDEX, "_ASSETS", 1);
@@ -610,13 +731,14 @@ void LoadApp(String appName) {
 				u64 lastWriteTime = GetFileLastWriteTime(file);
 				if (lastWriteTime > node.value.lastImportTime && node.value.enableAutoImport) {
 
-					i32 res = AssetImporter::ImportFile(g_pArenaFrame, node.value.importFormat, node.key, node.value.outputPath);
+					i32 res = AssetImporter::ImportFile(g_pArenaFrame, node.value.importFormat, node.key, node.value.outputPath, node.value.options);
 					if (res >= 0) {
 						pState->pImportTable->table[node.key] = AssetImporter::ImportTableAsset{
 							.outputPath = node.value.outputPath,
 							.enableAutoImport = true,
 							.lastImportTime = lastWriteTime,
-							.importFormat = node.value.importFormat
+							.importFormat = node.value.importFormat,
+							.options = node.value.options
 						};
 						continue;
 					}
@@ -683,6 +805,7 @@ void Start() {
 
 void Tick(f32 deltaTime) {
 	FileWatcherProcessChanges(pState->pWatcher);
+	UserDataNewFrame();
 
 	if (!pState->appLoaded) return;
 
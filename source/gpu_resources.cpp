@@ -0,0 +1,231 @@
+// Copyright 2020-2022 David Colson. All rights reserved.
+
+// Tracks the gpu objects we create on behalf of lua objects, so they get destroyed when the
+// lua side is collected, and so image memory stays under a budget. Images owned by userdata
+// can always be recreated from the userdata's own pixels, so when we're over budget the least
+// recently used ones are destroyed and will be uploaded again next time they're bound.
+// All of this runs on the simulation thread, sokol calls take the gpu lock.
+
+namespace GpuResources {
+
+struct GpuResource {
+	bool isImage;
+	u32 id;
+	i64 bytes;
+	u64 lastUsedFrame;
+	UserData* pOwner; // only set for images we're allowed to evict
+};
+
+enum class ERetiredType : u8 {
+	Image,
+	Buffer,
+	Attachments
+};
+
+struct RetiredResource {
+	ERetiredType type;
+	u32 id;
+	u64 retiredFrame;
+};
+
+struct ResourceState {
+	ResizableArray<GpuResource> resources;
+	ResizableArray<RetiredResource> retired;
+	u64 frameIndex;
+	GpuResourceUsage usage;
+};
+
+static ResourceState* pResourceState;
+
+// ***********************************************************************
+
+void Init(Arena* pArena) {
+	pResourceState = New(pArena, ResourceState);
+	pResourceState->resources.pArena = pArena;
+	pResourceState->retired.pArena = pArena;
+	pResourceState->frameIndex = 0;
+	pResourceState->usage = GpuResourceUsage();
+	pResourceState->usage.budget = DEFAULT_VRAM_BUDGET;
+}
+
+// ***********************************************************************
+
+GpuResource* FindResource(bool isImage, u32 id) {
+	for (i64 i = 0; i < pResourceState->resources.count; i++) {
+		GpuResource& res = pResourceState->resources[i];
+		if (res.isImage == isImage && res.id == id)
+			return &res;
+	}
+	return nullptr;
+}
+
+// ***********************************************************************
+
+void RemoveResource(GpuResource* pResource) {
+	GpuResourceUsage& usage = pResourceState->usage;
+	if (pResource->isImage) {
+		// ids aren't reused, so nothing will ask for this version again
+		ForgetTextureVersion(sg_image { pResource->id });
+		usage.images--;
+		usage.imageBytes -= pResource->bytes;
+	} else {
+		usage.buffers--;
+		usage.bufferBytes -= pResource->bytes;
+	}
+
+	// order doesn't matter, swap with the last one
+	ResizableArray<GpuResource>& resources = pResourceState->resources;
+	*pResource = resources[resources.count - 1];
+	resources.count--;
+}
+
+// ***********************************************************************
+
+void EnforceBudget(i64 incomingBytes) {
+	GpuResourceUsage& usage = pResourceState->usage;
+	while (usage.imageBytes + incomingBytes > usage.budget) {
+		// frameIndex is the frame being built and the render thread may still be drawing the one before it,
+		// so only images unused by either are candidates. NewFrame runs after the fence, which keeps this true
+		GpuResource* pOldest = nullptr;
+		for (i64 i = 0; i < pResourceState->resources.count; i++) {
+			GpuResource& res = pResourceState->resources[i];
+			if (!res.isImage || res.pOwner == nullptr)
+				continue;
+			if (res.lastUsedFrame + 1 >= pResourceState->frameIndex)
+				continue;
+			if (pOldest == nullptr || res.lastUsedFrame < pOldest->lastUsedFrame)
+				pOldest = &res;
+		}
+		if (pOldest == nullptr)
+			return; // everything is in use, we'll have to go over
+
+		sg_image image = { pOldest->id };
+		pOldest->pOwner->img.id = SG_INVALID_ID;
+		pOldest->pOwner->dynamic = false;
+
+		LockGpu();
+		sg_destroy_image(image);
+		UnlockGpu();
+
+		RemoveResource(pOldest);
+		usage.evictions++;
+	}
+}
+
+// ***********************************************************************
+
+void NewFrame() {
+	pResourceState->frameIndex++;
+	EnforceBudget(0);
+}
+
+// ***********************************************************************
+
+void TrackImage(sg_image image, i64 bytes, UserData* pOwner) {
+	EnforceBudget(bytes);
+
+	GpuResource res;
+	res.isImage = true;
+	res.id = image.id;
+	res.bytes = bytes;
+	res.lastUsedFrame = pResourceState->frameIndex;
+	res.pOwner = pOwner;
+	pResourceState->resources.PushBack(res);
+
+	pResourceState->usage.images++;
+	pResourceState->usage.imageBytes += bytes;
+}
+
+// ***********************************************************************
+
+void TrackBuffer(sg_buffer buffer, i64 bytes) {
+	GpuResource res;
+	res.isImage = false;
+	res.id = buffer.id;
+	res.bytes = bytes;
+	res.lastUsedFrame = pResourceState->frameIndex;
+	res.pOwner = nullptr;
+	pResourceState->resources.PushBack(res);
+
+	pResourceState->usage.buffers++;
+	pResourceState->usage.bufferBytes += bytes;
+}
+
+// ***********************************************************************
+
+void Retire(ERetiredType type, u32 id) {
+	RetiredResource retired;
+	retired.type = type;
+	retired.id = id;
+	retired.retiredFrame = pResourceState->frameIndex;
+	pResourceState->retired.PushBack(retired);
+}
+
+// ***********************************************************************
+
+void RetireImage(sg_image image) {
+	if (GpuResource* pRes = FindResource(true, image.id))
+		RemoveResource(pRes);
+	Retire(ERetiredType::Image, image.id);
+}
+
+// ***********************************************************************
+
+void RetireBuffer(sg_buffer buffer) {
+	if (GpuResource* pRes = FindResource(false, buffer.id))
+		RemoveResource(pRes);
+	Retire(ERetiredType::Buffer, buffer.id);
+}
+
+// ***********************************************************************
+
+void RetireAttachments(sg_attachments attachments) {
+	// never tracked, there's no memory of their own
+	Retire(ERetiredType::Attachments, attachments.id);
+}
+
+// ***********************************************************************
+
+void DestroyRetired() {
+	// anything retired while building the frame about to be handed over may still be drawn by it, same rule as EnforceBudget
+	ResizableArray<RetiredResource>& retired = pResourceState->retired;
+	LockGpu();
+	for (i64 i = 0; i < retired.count; i++) {
+		if (retired[i].retiredFrame + 1 >= pResourceState->frameIndex)
+			continue;
+
+		switch (retired[i].type) {
+			case ERetiredType::Image: sg_destroy_image(sg_image { retired[i].id }); break;
+			case ERetiredType::Buffer: sg_destroy_buffer(sg_buffer { retired[i].id }); break;
+			case ERetiredType::Attachments: sg_destroy_attachments(sg_attachments { retired[i].id }); break;
+		}
+
+		// order doesn't matter, swap with the last one
+		retired[i] = retired[retired.count - 1];
+		retired.count--;
+		i--;
+	}
+	UnlockGpu();
+}
+
+// ***********************************************************************
+
+void TouchImage(sg_image image) {
+	if (GpuResource* pRes = FindResource(true, image.id))
+		pRes->lastUsedFrame = pResourceState->frameIndex;
+}
+
+// ***********************************************************************
+
+void SetBudget(i64 bytes) {
+	pResourceState->usage.budget = bytes;
+	EnforceBudget(0);
+}
+
+// ***********************************************************************
+
+GpuResourceUsage GetUsage() {
+	return pResourceState->usage;
+}
+
+}
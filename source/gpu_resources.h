@@ -0,0 +1,40 @@
+// Copyright 2020-2022 David Colson. All rights reserved.
+
+#pragma once
+
+struct UserData;
+
+#define DEFAULT_VRAM_BUDGET (32 * 1024 * 1024)
+
+struct GpuResourceUsage {
+	i32 images;
+	i32 buffers;
+	i64 imageBytes;
+	i64 bufferBytes;
+	i64 budget;
+	i32 evictions;
+};
+
+namespace GpuResources {
+
+void Init(Arena* pArena);
+// Call after waiting for the render thread, evicts over budget images the previous frame no longer needs
+void NewFrame();
+
+void TrackImage(sg_image image, i64 bytes, UserData* pOwner);
+void TrackBuffer(sg_buffer buffer, i64 bytes);
+
+// Stops tracking now but destroys once the frames that might still draw with it are done
+void RetireImage(sg_image image);
+void RetireBuffer(sg_buffer buffer);
+void RetireAttachments(sg_attachments attachments);
+
+// Call after waiting for the render thread, destroys whatever has been retired long enough
+void DestroyRetired();
+
+void TouchImage(sg_image image);
+
+void SetBudget(i64 bytes);
+GpuResourceUsage GetUsage();
+
+}
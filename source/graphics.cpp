@@ -2,17 +2,126 @@
 // shaders
 #include "core3d.h"
 #include "compositor.h"
+#include "dither.h"
 
 // this is derived from the ps1's supposed 90k poly's per second with lighting and mapping
 // probably will want to increase this at some point
 #define MAX_VERTICES_PER_FRAME 9000 
 
+// particle billboards go in the packed stream, which gets room for 50k of them on top
+#define MAX_PARTICLE_VERTICES_PER_FRAME (50000 * 6)
+#define MAX_PACKED_VERTICES_PER_FRAME (MAX_VERTICES_PER_FRAME + MAX_PARTICLE_VERTICES_PER_FRAME)
+
+// core3D is compiled into permutations rather than branching on uniforms
+// these bits index the variant table, and match the program order in core3d.shader
+#define SHADER_VARIANT_LIT (1 << 0)
+#define SHADER_VARIANT_FOG (1 << 1)
+#define SHADER_VARIANT_TEXTURED (1 << 2)
+#define SHADER_VARIANT_VRAM (1 << 3)
+#define SHADER_VARIANT_ARRAY (1 << 4)
+#define SHADER_VARIANT_COUNT (1 << 5)
+#define PIPELINE_COUNT (SHADER_VARIANT_COUNT * (i32)EVertexFormat::Count * 2 * (i32)EPrimitiveType::Count * 2 * _SG_CULLMODE_NUM)
+
+// dynamic resolution averages render times over this many frames before changing step,
+// and only steps back up if the bigger step is predicted to fit in this fraction of the budget
+#define DYNAMIC_RESOLUTION_WINDOW 30
+#define DYNAMIC_RESOLUTION_HEADROOM 0.85f
+
+// compiled user shaders are stored here keyed by the hash of their full source
+#define USER_SHADER_CACHE_PATH "system/shader_cache/"
+
+// tile maps are baked into retained vertex buffers in square chunks of this many tiles
+#define MAP_CHUNK_SIZE 16
+#define MAP_CHUNK_VERTICES (MAP_CHUNK_SIZE * MAP_CHUNK_SIZE * 6)
+#define MAP_CHUNK_MAX_AGE 60
+
+// terrain chunks are a grid of this many cells a side, plus a skirt hanging off each edge.
+// every lod uses the same vertices with a coarser index pattern, so one index buffer serves all chunks
+#define TERRAIN_CHUNK_SIZE 32
+#define TERRAIN_CHUNK_GRID_VERTICES ((TERRAIN_CHUNK_SIZE + 1) * (TERRAIN_CHUNK_SIZE + 1))
+#define TERRAIN_CHUNK_VERTICES (TERRAIN_CHUNK_GRID_VERTICES + 4 * (TERRAIN_CHUNK_SIZE + 1))
+#define TERRAIN_LOD_COUNT 4
+#define TERRAIN_LOD_DISTANCE 2.0f // in chunk lengths, doubling for each lod after
+
+typedef const sg_shader_desc* (*ShaderDescFunc)(sg_backend);
+static const ShaderDescFunc core3DVariants[SHADER_VARIANT_COUNT] = {
+	core3D_shader_desc,
+	core3D_lit_shader_desc,
+	core3D_fog_shader_desc,
+	core3D_lit_fog_shader_desc,
+	core3D_tex_shader_desc,
+	core3D_lit_tex_shader_desc,
+	core3D_fog_tex_shader_desc,
+	core3D_lit_fog_tex_shader_desc,
+	core3D_vram_shader_desc,
+	core3D_lit_vram_shader_desc,
+	core3D_fog_vram_shader_desc,
+	core3D_lit_fog_vram_shader_desc,
+	// vram draws never set the textured bit
+	nullptr, nullptr, nullptr, nullptr,
+	core3D_array_shader_desc,
+	core3D_lit_array_shader_desc,
+	core3D_fog_array_shader_desc,
+	core3D_lit_fog_array_shader_desc,
+	// nor do array draws set the textured or vram bits
+	nullptr, nullptr, nullptr, nullptr,
+	nullptr, nullptr, nullptr, nullptr,
+	nullptr, nullptr, nullptr, nullptr
+};
+
+// User pixel shaders are plain hlsl that define an effect function, they get wrapped
+// into a full pixel shader that matches the outputs of the core3D vertex variants
+static const char* userShaderPrefix = R"HLSL(
+cbuffer user_shader_params : register(b0) {
+	float4 fogColor;
+	float4 params[4];
+};
+Texture2D<float4> tex : register(t0);
+SamplerState nearestSampler : register(s0);
+#line 1
+)HLSL";
+
+static const char* userShaderSuffix = R"HLSL(
+struct PixelInput {
+	noperspective float4 color : TEXCOORD0;
+	noperspective float2 uv : TEXCOORD1;
+	float fogDensity : TEXCOORD2;
+	float4 fragCoord : SV_Position;
+};
+
+float4 main(PixelInput input) : SV_Target0 {
+	float4 result = effect(input.color, tex, nearestSampler, input.uv, input.fragCoord.xy);
+	if (result.a <= 0.01) {
+		discard;
+	}
+	// unfogged vertex variants output zero density
+	result.rgb = lerp(result.rgb, fogColor.rgb, input.fogDensity);
+	return result;
+}
+)HLSL";
+
+// matches the user_shader_params cbuffer above
+struct UserShaderParams {
+	Vec4f fogColor;
+	Vec4f params[MAX_SHADER_PARAMS];
+};
+
 struct DrawCommand {
 	i32 vertexBufferOffset;	
 	i32 indexBufferOffset;	
 	i32 numElements;
+	i32 numVertices;
+	sg_buffer vertexBuffer { SG_INVALID_ID }; // retained buffer, otherwise the transient one is used
+	sg_buffer indexBuffer { SG_INVALID_ID }; // same again for indices
 	bool indexedDraw;
 	bool texturedDraw;
+	bool occlusionTest { false };
+	Vec3f boundsMin;
+	Vec3f boundsMax;
+	u32 shaderVariant;
+	i32 userShader { -1 };
+	Vec4f shaderParams[MAX_SHADER_PARAMS];
+	EVertexFormat vertexFormat;
 	sg_cull_mode cullMode;
 	sg_image texture;
 	EPrimitiveType type;
@@ -20,18 +129,105 @@ struct DrawCommand {
 	fs_core3d_params_t fsUniforms;
 };
 
+struct UserShader {
+	u64 hash;
+	sg_range bytecode;
+
+	// made on first use, same layout as the core3D shaders and pipelines
+	sg_shader shaders[SHADER_VARIANT_COUNT];
+	sg_pipeline pipelines[PIPELINE_COUNT];
+};
+
+// impostor atlases are drawn by the render thread at the start of the frame they're submitted with
+struct ImpostorBake {
+	sg_attachments attachments;
+	sg_buffer vertexBuffer;
+	i32 vertexCount;
+	sg_image texture;
+	i32 views;
+	i32 resolution;
+	Vec3f center;
+	f32 radius;
+	bool lit;
+	Vec4f lightDirection[MAX_LIGHTS];
+	Vec4f lightColor[MAX_LIGHTS];
+	Vec3f lightAmbient;
+};
+
+// pixels for a stream image, sokol only takes one update per image per frame
+struct ImageUpdate {
+	sg_image image;
+	i64 offset; // into the frame's imagePixels
+	i64 size;
+};
+
+struct TextureVersion {
+	u32 imageId;
+	u32 version;
+};
+
+struct MapChunk {
+	u8* pTiles; // which map this belongs to, content changes are caught by the hash
+	u32 tileset;
+	i32 tileSize;
+	i32 chunkX;
+	i32 chunkY;
+	u64 hash;
+	sg_buffer vertexBuffer;
+	u64 lastUsedFrame;
+};
+
+// Everything the render thread needs to submit one frame. The simulation thread
+// builds one of these while the render thread submits the other
+struct FrameData {
+	Vec2f resolution3D;
+	ResizableArray<DrawCommand> drawList3D;
+	ResizableArray<DrawCommand> drawList2D;
+	ResizableArray<VertexData> perFrameVertexBuffer;
+	ResizableArray<PackedVertexData> perFramePackedVertexBuffer;
+	ResizableArray<u16> perFrameIndexBuffer;
+	ResizableArray<Vec4f> occluderVerts;
+	ResizableArray<VramUpload> vramUploads;
+	ResizableArray<u16> vramPixels;
+	ResizableArray<ImageUpdate> imageUpdates;
+	ResizableArray<u8> imagePixels;
+	ResizableArray<ImpostorBake> impostorBakes;
+	Vec4f clearColor;
+	bool dither;
+	EDitherPattern ditherPattern;
+
+	// hashes of everything that affects each layer, if these match the last
+	// frame drawn then the framebuffer already has the right image in it
+	u64 layerHash3D;
+	u64 layerHash2D;
+
+	// counters from both threads, sim side while building and render side while submitting
+	RenderStats stats;
+};
+
 struct RenderState {
 	Arena* pArena;
 
 	Vec2f targetResolution;
 
+	// the 3D layer is drawn into the top left of its target at one of the resolutionSteps,
+	// picked from the render times of recent frames
+	Vec2f resolution3D;
+	bool dynamicResolutionState { false };
+	f32 frameBudget;
+	i32 resolutionStep;
+	f32 renderTimes[DYNAMIC_RESOLUTION_WINDOW];
+	i32 renderTimeCount;
+
 	// Drawing state
 	ERenderMode mode { ERenderMode::None };
 	EPrimitiveType typeState;
 	ResizableArray<VertexData> vertexState;
+	ResizableArray<u16> indexState;
 	Vec4f vertexColorState { Vec4f(0.0f, 0.0f, 0.0f, 0.0f) };
 	Vec2f vertexTexCoordState { Vec2f(0.0f, 0.0f) };
 	Vec3f vertexNormalState { Vec3f(0.0f, 0.0f, 0.0f) };
+	EVertexFormat vertexFormatState { EVertexFormat::Standard };
 
 	EMatrixMode matrixModeState;
 	Stack<Matrixf> matrixStates[(u64)EMatrixMode::Count];
@@ -42,67 +238,151 @@ struct RenderState {
 	Vec4f lightColorStates[MAX_LIGHTS];
 	Vec3f lightAmbientState { Vec3f(0.0f, 0.0f, 0.0f) };
 
+	bool ditherState { true };
+	EDitherPattern ditherPatternState { EDitherPattern::Bayer8 };
+
+	bool occlusionCullingState { false };
+	bool occluderState { false };
+
 	bool fogState { false };
 	Vec2f fogDepths { Vec2f(0.0f, 0.0f) };
 	Vec3f fogColor { Vec3f(0.f, 0.f, 0.f) };
 
 	sg_image textureState;
+	f32 textureLayerOffsetState { 0.0f };
+
+	// images made by CreateTextureArray, so draws know to use the array variants
+	ResizableArray<u32> textureArrays;
+
+	bool vramBoundState { false };
+	Vec4f vramPageState;
+	Vec4f vramClutState;
+
+	i32 userShaderState { -1 };
+	Vec4f shaderParamStates[MAX_SHADER_PARAMS];
+
+	// compiled once and never freed, so reloaded scripts find their shaders again
+	ResizableArray<UserShader> userShaders;
+
+	// baked tile map chunks, replaced buffers are retired until the render thread is done with them
+	ResizableArray<MapChunk> mapChunks;
+	u64 mapFrameIndex;
 
 	sg_cull_mode cullMode;
 
-	ResizableArray<DrawCommand> drawList3D;
-	ResizableArray<DrawCommand> drawList2D;
-	ResizableArray<VertexData> perFrameVertexBuffer;
-	ResizableArray<u16> perFrameIndexBuffer;
+	FrameData frames[2];
+	FrameData* pBuildFrame;
+	FrameData* pSubmitFrame;
+
+	// bumped whenever a texture's contents change, so cached layers know to redraw
+	ResizableArray<TextureVersion> textureVersions;
+	Vec4f clearColorState { Vec4f(0.25f, 0.25f, 0.25f, 1.0f) };
+
+	// render thread only, what is currently in the layer framebuffers
+	bool layersValid { false };
+	u64 drawnLayerHash3D;
+	u64 drawnLayerHash2D;
+
+	// stats of the last frame the render thread completed
+	RenderStats lastFrameStats;
+
+	// render thread
+	SDL_Thread* pRenderThread;
+	SDL_sem* pFrameReady; // posted when pSubmitFrame has a new frame in it
+	SDL_sem* pRenderIdle; // posted when the render thread is done with pSubmitFrame
+	SDL_mutex* pGpuLock; // sokol is not thread safe, so anyone touching gpu resources must hold this
+	bool renderThreadQuit;
+	i32 winWidth;
+	i32 winHeight;
 	
 	// Sokol rendering data
 	
-	// pipelines
+	// shaders and pipelines
+	sg_shader shaderCore3D[SHADER_VARIANT_COUNT];
 	sg_pipeline pipeCompositor;
-	sg_pipeline pipeMain[2 * 2 * (i32)EPrimitiveType::Count];
+	sg_pipeline pipeDither;
+	sg_pipeline pipeMain[PIPELINE_COUNT];
 
 	// passes
 	sg_pass passCore3DScene;
 	sg_pass passCore2DScene;
 	sg_pass passCompositor;
+	sg_pass passDither3D;
+	sg_pass passDither2D;
 
 	// persistent Buffers
 	sg_buffer fullscreenTriangle;
 	sg_buffer transientVertexBuffer;
+	sg_buffer transientPackedVertexBuffer;
 	sg_buffer transientIndexBuffer;
 
+	// shared by every terrain chunk, index ranges for each lod
+	sg_buffer terrainIndexBuffer;
+	i32 terrainLodOffsets[TERRAIN_LOD_COUNT];
+	i32 terrainLodCounts[TERRAIN_LOD_COUNT];
+
 	// framebuffers
 	sg_image fbCore3DScene;
 	sg_image fbCore2DScene;
+	sg_image fbDither3D;
+	sg_image fbDither2D;
 
-	// samplers 
-	sg_sampler samplerNearest;
+	// ordered dither threshold textures, indexed by EDitherPattern
+	sg_image ditherPatterns[(i32)EDitherPattern::Count];
 
-	// misc
+	// user shaders always have a texture slot, untextured draws bind this
 	sg_image whiteTexture;
+
+	// samplers 
+	sg_sampler samplerNearest;
 };
 
 RenderState* pRenderState;
 
 // ***********************************************************************
 
-sg_pipeline& GetPipeline(bool indexed, EPrimitiveType primitive, bool writeAlpha, sg_cull_mode cullMode) {
-	u32 index = (i32)indexed + (i32)primitive + (i32)writeAlpha + (i32)cullMode;
-	if (pRenderState->pipeMain[index].id != SG_INVALID_ID) {
-		return pRenderState->pipeMain[index];
+sg_shader MakeUserShader(UserShader& userShader, u32 shaderVariant) {
+	// borrow the vertex stage and bindings from the matching core3D variant, only the pixel shader is the user's
+	sg_shader_desc desc = *core3DVariants[shaderVariant | SHADER_VARIANT_TEXTURED](SG_BACKEND_D3D11);
+	desc.fs.bytecode = userShader.bytecode;
+	desc.fs.uniform_blocks[0].size = sizeof(UserShaderParams);
+	desc.fs.uniform_blocks[0].layout = SG_UNIFORMLAYOUT_STD140;
+	desc.label = "user shader";
+	return sg_make_shader(&desc);
+}
+
+// ***********************************************************************
+
+sg_pipeline& GetPipeline(u32 shaderVariant, i32 userShader, EVertexFormat format, bool indexed, EPrimitiveType primitive, bool writeAlpha, sg_cull_mode cullMode) {
+	u32 index = shaderVariant;
+	index = index * (u32)EVertexFormat::Count + (u32)format;
+	index = index * 2 + (u32)indexed;
+	index = index * (u32)EPrimitiveType::Count + (u32)primitive;
+	index = index * 2 + (u32)writeAlpha;
+	index = index * _SG_CULLMODE_NUM + (u32)cullMode;
+
+	// user shaders have their own tables, indexed the same way
+	sg_pipeline* pPipelines = pRenderState->pipeMain;
+	sg_shader* pShaders = pRenderState->shaderCore3D;
+	if (userShader >= 0) {
+		pPipelines = pRenderState->userShaders[userShader].pipelines;
+		pShaders = pRenderState->userShaders[userShader].shaders;
+	}
+
+	if (pPipelines[index].id != SG_INVALID_ID) {
+		return pPipelines[index];
+	}
+
+	sg_shader& shader = pShaders[shaderVariant];
+	if (shader.id == SG_INVALID_ID) {
+		if (userShader >= 0)
+			shader = MakeUserShader(pRenderState->userShaders[userShader], shaderVariant);
+		else
+			shader = sg_make_shader(core3DVariants[shaderVariant](SG_BACKEND_D3D11));
 	}
 
 	sg_pipeline_desc pipelineDesc = {
-		.shader = sg_make_shader(core3D_shader_desc(SG_BACKEND_D3D11)),
-		.layout = {
-			.buffers = { {.stride = sizeof(VertexData) } },
-			.attrs = {
-				{ .offset = offsetof(VertexData, pos), .format = SG_VERTEXFORMAT_FLOAT3 },
-				{ .offset = offsetof(VertexData, col), .format = SG_VERTEXFORMAT_FLOAT4 },
-				{ .offset = offsetof(VertexData, tex), .format = SG_VERTEXFORMAT_FLOAT2 },
-				{ .offset = offsetof(VertexData, norm), .format = SG_VERTEXFORMAT_FLOAT3 }
-			}
-		},
+		.shader = shader,
 		.depth = {
 			.pixel_format = SG_PIXELFORMAT_DEPTH,
 			.compare = SG_COMPAREFUNC_LESS_EQUAL,
@@ -121,6 +401,23 @@ sg_pipeline& GetPipeline(bool indexed, EPrimitiveType primitive, bool writeAlpha
 		.cull_mode = cullMode
 	};
 
+	switch(format) {
+		case EVertexFormat::Packed:
+			pipelineDesc.layout.buffers[0].stride = sizeof(PackedVertexData);
+			pipelineDesc.layout.attrs[ATTR_vs_core3D_pos] = { .offset = offsetof(PackedVertexData, pos), .format = SG_VERTEXFORMAT_SHORT4N };
+			pipelineDesc.layout.attrs[ATTR_vs_core3D_color0] = { .offset = offsetof(PackedVertexData, col), .format = SG_VERTEXFORMAT_UBYTE4N };
+			pipelineDesc.layout.attrs[ATTR_vs_core3D_texcoord] = { .offset = offsetof(PackedVertexData, tex), .format = SG_VERTEXFORMAT_SHORT2N };
+			pipelineDesc.layout.attrs[ATTR_vs_core3D_normal] = { .offset = offsetof(PackedVertexData, norm), .format = SG_VERTEXFORMAT_BYTE4N };
+		break;
+		default:
+			pipelineDesc.layout.buffers[0].stride = sizeof(VertexData);
+			pipelineDesc.layout.attrs[ATTR_vs_core3D_pos] = { .offset = offsetof(VertexData, pos), .format = SG_VERTEXFORMAT_FLOAT3 };
+			pipelineDesc.layout.attrs[ATTR_vs_core3D_color0] = { .offset = offsetof(VertexData, col), .format = SG_VERTEXFORMAT_FLOAT4 };
+			pipelineDesc.layout.attrs[ATTR_vs_core3D_texcoord] = { .offset = offsetof(VertexData, tex), .format = SG_VERTEXFORMAT_FLOAT2 };
+			pipelineDesc.layout.attrs[ATTR_vs_core3D_normal] = { .offset = offsetof(VertexData, norm), .format = SG_VERTEXFORMAT_FLOAT3 };
+		break;
+	}
+
 	switch(primitive) {
 		case EPrimitiveType::Points:
 			pipelineDesc.primitive_type = SG_PRIMITIVETYPE_POINTS;	
@@ -154,8 +451,8 @@ sg_pipeline& GetPipeline(bool indexed, EPrimitiveType primitive, bool writeAlpha
 		pipelineDesc.colors[0].write_mask = SG_COLORMASK_RGB;
 	}
 
-	pRenderState->pipeMain[index] = sg_make_pipeline(pipelineDesc);
-	return pRenderState->pipeMain[index];
+	pPipelines[index] = sg_make_pipeline(pipelineDesc);
+	return pPipelines[index];
 }
 
 // ***********************************************************************
@@ -213,46 +510,142 @@ void CreateFullScreenQuad(f32 _textureWidth, f32 _textureHeight, f32 _texelHalf,
 	pRenderState->fullscreenTriangle = sg_make_buffer(&vbufferDesc);
 }
 
+// ***********************************************************************
+
+sg_image CreateBayerPattern(i32 size) {
+	// grow the matrix recursively, M2n[i][j] = 4 * Mn[i%n][j%n] + M2[i/n][j/n]
+	i32 matrix[8][8] = { { 0 } };
+	for (i32 n = 1; n < size; n *= 2) {
+		const i32 base[2][2] = { { 0, 2 }, { 3, 1 } };
+		i32 next[8][8];
+		for (i32 i = 0; i < n * 2; i++) {
+			for (i32 j = 0; j < n * 2; j++) {
+				next[i][j] = 4 * matrix[i % n][j % n] + base[i / n][j / n];
+			}
+		}
+		memcpy(matrix, next, sizeof(matrix));
+	}
+
+	// store as thresholds in 0-1 so the shader can compare directly
+	u8 pixels[8 * 8 * 4];
+	for (i32 y = 0; y < size; y++) {
+		for (i32 x = 0; x < size; x++) {
+			u8 threshold = (u8)(255 * (matrix[x][y] + 1) / (size * size));
+			u8* pPixel = &pixels[(y * size + x) * 4];
+			pPixel[0] = threshold;
+			pPixel[1] = threshold;
+			pPixel[2] = threshold;
+			pPixel[3] = 255;
+		}
+	}
+
+	sg_image_desc imageDesc = {
+		.width = size,
+		.height = size,
+		.pixel_format = SG_PIXELFORMAT_RGBA8,
+	};
+	imageDesc.data.subimage[0][0] = { pixels, (size_t)(size * size * 4) };
+	return sg_make_image(&imageDesc);
+}
+
+// ***********************************************************************
+
+void PushTerrainQuad(ResizableArray<u16>& indices, i32 a, i32 b, i32 c, i32 d) {
+	// a b c d go round the quad counter clockwise seen from the front
+	indices.PushBack((u16)a);
+	indices.PushBack((u16)b);
+	indices.PushBack((u16)d);
+	indices.PushBack((u16)d);
+	indices.PushBack((u16)b);
+	indices.PushBack((u16)c);
+}
+
+// ***********************************************************************
+
+void CreateTerrainIndexBuffer() {
+	const i32 n = TERRAIN_CHUNK_SIZE;
+	const i32 row = TERRAIN_CHUNK_SIZE + 1;
+	ResizableArray<u16> indices(g_pArenaFrame);
+
+	for (i32 lod = 0; lod < TERRAIN_LOD_COUNT; lod++) {
+		i32 step = 1 << lod;
+		pRenderState->terrainLodOffsets[lod] = (i32)indices.count;
+
+		for (i32 z = 0; z < n; z += step) {
+			for (i32 x = 0; x < n; x += step) {
+				PushTerrainQuad(indices, z * row + x, (z + step) * row + x, (z + step) * row + x + step, z * row + x + step);
+			}
+		}
+
+		// skirts, edge vertices are followed by copies of them pushed down, in the order z = 0, z = n, x = 0, x = n
+		i32 skirt = TERRAIN_CHUNK_GRID_VERTICES;
+		for (i32 i = 0; i < n; i += step) {
+			i32 j = i + step;
+			PushTerrainQuad(indices, j, skirt + j, skirt + i, i);
+			PushTerrainQuad(indices, n * row + i, skirt + row + i, skirt + row + j, n * row + j);
+			PushTerrainQuad(indices, i * row, skirt + 2 * row + i, skirt + 2 * row + j, j * row);
+			PushTerrainQuad(indices, j * row + n, skirt + 3 * row + j, skirt + 3 * row + i, i * row + n);
+		}
+		pRenderState->terrainLodCounts[lod] = (i32)indices.count - pRenderState->terrainLodOffsets[lod];
+	}
+
+	sg_buffer_desc indexBufferDesc = {
+		.size = indices.count * sizeof(u16),
+		.type = SG_BUFFERTYPE_INDEXBUFFER,
+		.usage = SG_USAGE_IMMUTABLE,
+		.data = { indices.pData, indices.count * sizeof(u16) },
+		.label = "Terrain indices"
+	};
+	pRenderState->terrainIndexBuffer = sg_make_buffer(&indexBufferDesc);
+}
 
 // ***********************************************************************
 
+int RenderThread(void* pUserData);
+
 void GraphicsInit(SDL_Window* pWindow, i32 winWidth, i32 winHeight) {
 	Arena* pArena = ArenaCreate();
 	pRenderState = New(pArena, RenderState);
 	pRenderState->pArena = pArena;
+	Occlusion::Init(pArena);
+	GpuResources::Init(pArena);
 
 	pRenderState->vertexState.pArena = pArena;
-	pRenderState->drawList3D.pArena = pArena;
-	pRenderState->drawList2D.pArena = pArena;
-	pRenderState->perFrameVertexBuffer.pArena = pArena;
-	pRenderState->perFrameIndexBuffer.pArena = pArena;
+	pRenderState->indexState.pArena = pArena;
+	for (i32 i = 0; i < 2; i++) {
+		FrameData& frame = pRenderState->frames[i];
+		frame.drawList3D.pArena = pArena;
+		frame.drawList2D.pArena = pArena;
+		frame.perFrameVertexBuffer.pArena = pArena;
+		frame.perFramePackedVertexBuffer.pArena = pArena;
+		frame.perFrameIndexBuffer.pArena = pArena;
+		frame.occluderVerts.pArena = pArena;
+		frame.vramUploads.pArena = pArena;
+		frame.vramPixels.pArena = pArena;
+		frame.imageUpdates.pArena = pArena;
+		frame.imagePixels.pArena = pArena;
+		frame.impostorBakes.pArena = pArena;
+	}
+	pRenderState->textureVersions.pArena = pArena;
+	pRenderState->userShaders.pArena = pArena;
+	pRenderState->mapChunks.pArena = pArena;
+	pRenderState->textureArrays.pArena = pArena;
+	pRenderState->pBuildFrame = &pRenderState->frames[0];
+	pRenderState->pSubmitFrame = &pRenderState->frames[1];
 
 	pRenderState->targetResolution = Vec2f(320.0f, 240.0f);
+	pRenderState->resolution3D = pRenderState->targetResolution;
 
 	// init_backend stuff
 	GraphicsBackendInit(pWindow, winWidth, winHeight);
 	sg_desc desc = {
+		.pipeline_pool_size = 256,
 		.environment = SokolGetEnvironment()
 	};
 	sg_setup(&desc);
+	sg_enable_frame_stats();
 
-	// Create white texture for non textured draws
-	{
-		u32 pixels[4];
-		memset(pixels, 0xFF, sizeof(pixels));
-
-		sg_image_desc imageDesc = {
-			.type = SG_IMAGETYPE_2D,
-			.width = 2,
-			.height = 2,
-			.pixel_format = SG_PIXELFORMAT_RGBA8,
-			.label = "white"
-		};
-
-		imageDesc.data.subimage[0][0].ptr = (void*)pixels;
-		imageDesc.data.subimage[0][0].size = sizeof(pixels);
-		pRenderState->whiteTexture = sg_make_image(&imageDesc);
-	}
+	Vram::Init(pArena);
 
 	// Compositor Pipeline
 	{
@@ -287,6 +680,28 @@ void GraphicsInit(SDL_Window* pWindow, i32 winWidth, i32 winHeight) {
 		pRenderState->pipeCompositor = sg_make_pipeline(pipelineDesc);
 	}
 
+	// Dither Pipeline
+	{
+		sg_pipeline_desc pipelineDesc = {
+			.shader = sg_make_shader(dither_shader_desc(SG_BACKEND_D3D11)),
+			.layout = {
+				.buffers = { {.stride = sizeof(VertexData) } },
+				.attrs = {
+					{ .offset = offsetof(VertexData, pos), .format = SG_VERTEXFORMAT_FLOAT3 },
+					{ .offset = offsetof(VertexData, col), .format = SG_VERTEXFORMAT_FLOAT4 },
+					{ .offset = offsetof(VertexData, tex), .format = SG_VERTEXFORMAT_FLOAT2 },
+					{ .offset = offsetof(VertexData, norm), .format = SG_VERTEXFORMAT_FLOAT3 }
+				}
+			},
+			.depth = {
+				.pixel_format = SG_PIXELFORMAT_NONE,
+			},
+			.index_type = SG_INDEXTYPE_NONE,
+			.cull_mode = SG_CULLMODE_BACK
+		};
+		pRenderState->pipeDither = sg_make_pipeline(pipelineDesc);
+	}
+
 	// Create persistent buffers
 	{
 		CreateFullScreenQuad((f32)winWidth, (f32)winHeight, 0.0f, true, 0.0f);
@@ -297,6 +712,9 @@ void GraphicsInit(SDL_Window* pWindow, i32 winWidth, i32 winHeight) {
 		};
 		pRenderState->transientVertexBuffer = sg_make_buffer(&vertexBufferDesc);
 
+		vertexBufferDesc.size = MAX_PACKED_VERTICES_PER_FRAME * sizeof(PackedVertexData);
+		pRenderState->transientPackedVertexBuffer = sg_make_buffer(&vertexBufferDesc);
+
 		sg_buffer_desc indexBufferDesc = {
 			.size = MAX_VERTICES_PER_FRAME * sizeof(u16),
 			.type = SG_BUFFERTYPE_INDEXBUFFER,
@@ -304,6 +722,8 @@ void GraphicsInit(SDL_Window* pWindow, i32 winWidth, i32 winHeight) {
 		};
 		pRenderState->transientIndexBuffer = sg_make_buffer(&indexBufferDesc);
 
+		CreateTerrainIndexBuffer();
+
 	}
 
 	// Create core3D scene pass
@@ -362,6 +782,44 @@ void GraphicsInit(SDL_Window* pWindow, i32 winWidth, i32 winHeight) {
 		};
 	}
 
+	// Create dither passes, these take a finished layer and write the quantised version out
+	{
+		sg_image_desc viewDesc = {
+			.render_target = true,
+			.width = 320,
+			.height = 240,
+			.sample_count = 1
+		};
+		pRenderState->fbDither3D = sg_make_image(&viewDesc);
+		pRenderState->fbDither2D = sg_make_image(&viewDesc);
+
+		sg_attachments_desc attachmentsDesc = {
+			.colors = { {.image = pRenderState->fbDither3D } },
+		};
+		pRenderState->passDither3D = { 
+			.action = {
+				.colors = {
+					{ .load_action = SG_LOADACTION_DONTCARE } 
+				}
+			},
+			.attachments = sg_make_attachments(&attachmentsDesc)
+		};
+
+		attachmentsDesc.colors[0].image = pRenderState->fbDither2D;
+		pRenderState->passDither2D = { 
+			.action = {
+				.colors = {
+					{ .load_action = SG_LOADACTION_DONTCARE } 
+				}
+			},
+			.attachments = sg_make_attachments(&attachmentsDesc)
+		};
+
+		pRenderState->ditherPatterns[(i32)EDitherPattern::Bayer2] = CreateBayerPattern(2);
+		pRenderState->ditherPatterns[(i32)EDitherPattern::Bayer4] = CreateBayerPattern(4);
+		pRenderState->ditherPatterns[(i32)EDitherPattern::Bayer8] = CreateBayerPattern(8);
+	}
+
 	// Create compositor
 	{
 		pRenderState->passCompositor = { 
@@ -383,135 +841,703 @@ void GraphicsInit(SDL_Window* pWindow, i32 winWidth, i32 winHeight) {
 		pRenderState->samplerNearest = sg_make_sampler(&samplerDesc);
 	}
 
-	pRenderState->perFrameVertexBuffer.Reserve(MAX_VERTICES_PER_FRAME);
-	pRenderState->perFrameIndexBuffer.Reserve(MAX_VERTICES_PER_FRAME);
+	// Create white texture for untextured user shader draws
+	{
+		u32 white = 0xffffffff;
+		sg_image_desc imageDesc = {
+			.width = 1,
+			.height = 1,
+			.pixel_format = SG_PIXELFORMAT_RGBA8,
+		};
+		imageDesc.data.subimage[0][0] = { &white, sizeof(white) };
+		pRenderState->whiteTexture = sg_make_image(&imageDesc);
+	}
+
+	for (i32 i = 0; i < 2; i++) {
+		pRenderState->frames[i].perFrameVertexBuffer.Reserve(MAX_VERTICES_PER_FRAME);
+		pRenderState->frames[i].perFramePackedVertexBuffer.Reserve(MAX_PACKED_VERTICES_PER_FRAME);
+		pRenderState->frames[i].perFrameIndexBuffer.Reserve(MAX_VERTICES_PER_FRAME);
+		pRenderState->frames[i].vramPixels.Reserve(VRAM_WIDTH * VRAM_HEIGHT);
+	}
 
 	for (u64 i = 0; i < 3; i++) {
 		pRenderState->matrixStates[i].array.pArena = pArena;
         pRenderState->matrixStates[i].Push(Matrixf::Identity());
 	}
+
+	pRenderState->winWidth = winWidth;
+	pRenderState->winHeight = winHeight;
+	pRenderState->pFrameReady = SDL_CreateSemaphore(0);
+	pRenderState->pRenderIdle = SDL_CreateSemaphore(1);
+	pRenderState->pGpuLock = SDL_CreateMutex();
+	pRenderState->renderThreadQuit = false;
+	pRenderState->pRenderThread = SDL_CreateThread(RenderThread, "Render", nullptr);
 }
 
 // ***********************************************************************
 
-void DrawFrame(i32 w, i32 h) {
-	// TODO: Sort the draw list to minimise state changes
-
-	// Update the global vertex buffer
-	if (pRenderState->perFrameVertexBuffer.count > 0) {
-		sg_range vtxData;
-		vtxData.ptr = (void*)pRenderState->perFrameVertexBuffer.pData;
-		vtxData.size = pRenderState->perFrameVertexBuffer.count * sizeof(VertexData);
-		sg_update_buffer(pRenderState->transientVertexBuffer, &vtxData);
-	}
+void GraphicsShutdown() {
+	// let the in flight frame finish, then wake the thread up to tell it to leave
+	SDL_SemWait(pRenderState->pRenderIdle);
+	pRenderState->renderThreadQuit = true;
+	SDL_SemPost(pRenderState->pFrameReady);
+	SDL_WaitThread(pRenderState->pRenderThread, nullptr);
+}
 
-	if (pRenderState->perFrameIndexBuffer.count > 0) {
-		sg_range idxData;
-		idxData.ptr = (void*)pRenderState->perFrameIndexBuffer.pData;
-		idxData.size = pRenderState->perFrameIndexBuffer.count * sizeof(u16);
-		sg_update_buffer(pRenderState->transientIndexBuffer, &idxData);
-	}
+// ***********************************************************************
 
-	// Draw 3D view into texture
-	{
-		sg_begin_pass(&pRenderState->passCore3DScene);
+void LockGpu() {
+	SDL_LockMutex(pRenderState->pGpuLock);
+}
 
-		sg_apply_viewport(0, 0, (i32)pRenderState->targetResolution.x, (i32)pRenderState->targetResolution.y, true);
-		sg_apply_scissor_rect(0, 0, (i32)pRenderState->targetResolution.x, (i32)pRenderState->targetResolution.y, true);
+// ***********************************************************************
 
-		for(i32 i = 0; i < pRenderState->drawList3D.count; i++) {
-			DrawCommand& cmd = pRenderState->drawList3D[i];
+void UnlockGpu() {
+	SDL_UnlockMutex(pRenderState->pGpuLock);
+}
 
-			sg_pipeline& pipeline = GetPipeline(cmd.indexedDraw, cmd.type, false, cmd.cullMode);
-			sg_apply_pipeline(pipeline);
-			
-			sg_bindings bind{0};
-			bind.vertex_buffers[0] = pRenderState->transientVertexBuffer;
-			bind.fs = {
-				.images = { pRenderState->whiteTexture },
-				.samplers = { pRenderState->samplerNearest }
-			};
+// ***********************************************************************
 
-			if (cmd.indexedDraw) {
-				bind.index_buffer = pRenderState->transientIndexBuffer;
-				bind.index_buffer_offset = cmd.indexBufferOffset;
+u64 HashBytes(u64 hash, const void* pData, u64 size) {
+	// fnv1a a word at a time, this runs over all the transient vertex data every frame.
+	// Large inputs are split over four lanes so the multiplies don't wait on each other
+	const u8* pBytes = (const u8*)pData;
+	u64 i = 0;
+	if (size >= 32) {
+		u64 lanes[4] = { hash, hash ^ 1, hash ^ 2, hash ^ 3 };
+		for (; i + 32 <= size; i += 32) {
+			for (i32 lane = 0; lane < 4; lane++) {
+				u64 word;
+				memcpy(&word, pBytes + i + lane * 8, sizeof(word));
+				lanes[lane] = (lanes[lane] ^ word) * 1099511628211ull;
 			}
+		}
+		hash = lanes[0];
+		for (i32 lane = 1; lane < 4; lane++)
+			hash = (hash ^ lanes[lane]) * 1099511628211ull;
+	}
+	for (; i + 8 <= size; i += 8) {
+		u64 word;
+		memcpy(&word, pBytes + i, sizeof(word));
+		hash = (hash ^ word) * 1099511628211ull;
+	}
+	for (; i < size; i++) {
+		hash ^= pBytes[i];
+		hash *= 1099511628211ull;
+	}
+	return hash;
+}
 
-			if (cmd.texturedDraw) {
-				bind.fs.images[0] = cmd.texture;
-			}
+// ***********************************************************************
 
-			sg_range vsUniforms = SG_RANGE_REF(cmd.vsUniforms);
-			sg_apply_uniforms(SG_SHADERSTAGE_VS, 0, &vsUniforms);
-			sg_range fsUniforms = SG_RANGE_REF(cmd.fsUniforms);
-			sg_apply_uniforms(SG_SHADERSTAGE_FS, 0, &fsUniforms);
+u32 GetTextureVersion(sg_image image) {
+	for (i64 i = 0; i < pRenderState->textureVersions.count; i++) {
+		if (pRenderState->textureVersions[i].imageId == image.id)
+			return pRenderState->textureVersions[i].version;
+	}
+	return 0;
+}
 
-			bind.vertex_buffer_offsets[0] = cmd.vertexBufferOffset;
-			sg_apply_bindings(&bind);
-			sg_draw(0, cmd.numElements, 1); 
+// ***********************************************************************
+
+u64 HashDrawList(u64 hash, FrameData& frame, ResizableArray<DrawCommand>& drawList) {
+	for (i64 i = 0; i < drawList.count; i++) {
+		DrawCommand& cmd = drawList[i];
+
+		// uniform structs have padding in them, so only hash the fields the variant actually reads
+		hash = HashBytes(hash, &cmd.type, sizeof(cmd.type));
+		hash = HashBytes(hash, &cmd.shaderVariant, sizeof(cmd.shaderVariant));
+		hash = HashBytes(hash, &cmd.cullMode, sizeof(cmd.cullMode));
+		hash = HashBytes(hash, &cmd.numElements, sizeof(cmd.numElements));
+		hash = HashBytes(hash, &cmd.vsUniforms.mvp, sizeof(cmd.vsUniforms.mvp));
+		hash = HashBytes(hash, &cmd.vsUniforms.unpackScale, sizeof(cmd.vsUniforms.unpackScale));
+		if (cmd.shaderVariant & SHADER_VARIANT_LIT) {
+			hash = HashBytes(hash, &cmd.vsUniforms.model, sizeof(cmd.vsUniforms.model));
+			hash = HashBytes(hash, cmd.vsUniforms.lightDirection, sizeof(cmd.vsUniforms.lightDirection));
+			hash = HashBytes(hash, cmd.vsUniforms.lightColor, sizeof(cmd.vsUniforms.lightColor));
+			hash = HashBytes(hash, &cmd.vsUniforms.lightAmbient, sizeof(cmd.vsUniforms.lightAmbient));
+		}
+		if (cmd.shaderVariant & SHADER_VARIANT_FOG) {
+			hash = HashBytes(hash, &cmd.vsUniforms.modelView, sizeof(cmd.vsUniforms.modelView));
+			hash = HashBytes(hash, &cmd.vsUniforms.fogDepths, sizeof(cmd.vsUniforms.fogDepths));
+			hash = HashBytes(hash, &cmd.fsUniforms.fogColor, sizeof(cmd.fsUniforms.fogColor));
+		}
+		if (cmd.userShader >= 0) {
+			hash = HashBytes(hash, &cmd.userShader, sizeof(cmd.userShader));
+			hash = HashBytes(hash, cmd.shaderParams, sizeof(cmd.shaderParams));
+			hash = HashBytes(hash, &cmd.fsUniforms.fogColor, sizeof(cmd.fsUniforms.fogColor));
+		}
+		if (cmd.shaderVariant & SHADER_VARIANT_VRAM) {
+			hash = HashBytes(hash, &cmd.fsUniforms.vramPage, sizeof(cmd.fsUniforms.vramPage));
+			hash = HashBytes(hash, &cmd.fsUniforms.vramClut, sizeof(cmd.fsUniforms.vramClut));
+		}
+		if (cmd.shaderVariant & (SHADER_VARIANT_TEXTURED | SHADER_VARIANT_VRAM | SHADER_VARIANT_ARRAY)) {
+			u32 version = GetTextureVersion(cmd.texture);
+			hash = HashBytes(hash, &cmd.texture.id, sizeof(cmd.texture.id));
+			hash = HashBytes(hash, &version, sizeof(version));
+		}
+
+		// hash the geometry itself rather than where it sits in the transient buffers
+		if (cmd.vertexBuffer.id != SG_INVALID_ID) {
+			hash = HashBytes(hash, &cmd.vertexBuffer.id, sizeof(cmd.vertexBuffer.id));
+			hash = HashBytes(hash, &cmd.vertexBufferOffset, sizeof(cmd.vertexBufferOffset));
+		}
+		else if (cmd.vertexFormat == EVertexFormat::Packed) {
+			hash = HashBytes(hash, (u8*)frame.perFramePackedVertexBuffer.pData + cmd.vertexBufferOffset, cmd.numVertices * sizeof(PackedVertexData));
+		}
+		else {
+			hash = HashBytes(hash, (u8*)frame.perFrameVertexBuffer.pData + cmd.vertexBufferOffset, cmd.numVertices * sizeof(VertexData));
+		}
+		if (cmd.indexBuffer.id != SG_INVALID_ID) {
+			hash = HashBytes(hash, &cmd.indexBuffer.id, sizeof(cmd.indexBuffer.id));
+			hash = HashBytes(hash, &cmd.indexBufferOffset, sizeof(cmd.indexBufferOffset));
+		}
+		else if (cmd.indexedDraw) {
+			hash = HashBytes(hash, (u8*)frame.perFrameIndexBuffer.pData + cmd.indexBufferOffset, cmd.numElements * sizeof(u16));
 		}
-		sg_end_pass();
 	}
+	return hash;
+}
 
-	// experimental code to readback 3D view for cpu editing
-	// ReadbackImagePixels(pRenderState->fbCore3DScene, pRenderState->pPixelsData);
-	// memset(pRenderState->pPixelsData + 8000 * 4 * sizeof(u8), 0, 640); 
+// ***********************************************************************
 
-	// Draw 2D view into texture
-	{
-		sg_begin_pass(&pRenderState->passCore2DScene);
+bool CanMergeDraws(DrawCommand& a, DrawCommand& b) {
+	// only plain triangle lists sitting back to back in the transient buffer
+	if (a.vertexBuffer.id != SG_INVALID_ID || b.vertexBuffer.id != SG_INVALID_ID)
+		return false;
+	if (a.vertexFormat != EVertexFormat::Standard || b.vertexFormat != EVertexFormat::Standard)
+		return false;
+	if (a.indexedDraw || b.indexedDraw || a.occlusionTest || b.occlusionTest)
+		return false;
+	if (a.type != EPrimitiveType::Triangles || b.type != EPrimitiveType::Triangles)
+		return false;
+	if (a.vertexBufferOffset + a.numVertices * (i32)sizeof(VertexData) != b.vertexBufferOffset)
+		return false;
+
+	if (a.shaderVariant != b.shaderVariant || a.userShader != b.userShader || a.cullMode != b.cullMode)
+		return false;
+	if ((a.shaderVariant & (SHADER_VARIANT_TEXTURED | SHADER_VARIANT_VRAM | SHADER_VARIANT_ARRAY)) && a.texture.id != b.texture.id)
+		return false;
+
+	// uniform structs have padding in them, so compare field by field
+	vs_core3d_params_t& vsA = a.vsUniforms;
+	vs_core3d_params_t& vsB = b.vsUniforms;
+	if (memcmp(&vsA.mvp, &vsB.mvp, sizeof(vsA.mvp)) != 0 || memcmp(&vsA.model, &vsB.model, sizeof(vsA.model)) != 0 || memcmp(&vsA.modelView, &vsB.modelView, sizeof(vsA.modelView)) != 0)
+		return false;
+	if (memcmp(vsA.lightDirection, vsB.lightDirection, sizeof(vsA.lightDirection)) != 0 || memcmp(vsA.lightColor, vsB.lightColor, sizeof(vsA.lightColor)) != 0)
+		return false;
+	if (memcmp(&vsA.lightAmbient, &vsB.lightAmbient, sizeof(vsA.lightAmbient)) != 0 || memcmp(&vsA.fogDepths, &vsB.fogDepths, sizeof(vsA.fogDepths)) != 0)
+		return false;
+	if (memcmp(&a.fsUniforms.fogColor, &b.fsUniforms.fogColor, sizeof(a.fsUniforms.fogColor)) != 0)
+		return false;
+	if (memcmp(&a.fsUniforms.vramPage, &b.fsUniforms.vramPage, sizeof(a.fsUniforms.vramPage)) != 0 || memcmp(&a.fsUniforms.vramClut, &b.fsUniforms.vramClut, sizeof(a.fsUniforms.vramClut)) != 0)
+		return false;
+	if (a.userShader >= 0 && memcmp(a.shaderParams, b.shaderParams, sizeof(a.shaderParams)) != 0)
+		return false;
+	return true;
+}
 
-		sg_apply_viewport(0, 0, (i32)pRenderState->targetResolution.x, (i32)pRenderState->targetResolution.y, true);
-		sg_apply_scissor_rect(0, 0, (i32)pRenderState->targetResolution.x, (i32)pRenderState->targetResolution.y, true);
+// ***********************************************************************
 
-		for(i32 i = 0; i < pRenderState->drawList2D.count; i++) {
-			DrawCommand& cmd = pRenderState->drawList2D[i];
+// Folds runs of draws that share all their state into one, texture arrays make this
+// common, since draws on different layers of one array have the same texture
+i32 MergeDrawList(ResizableArray<DrawCommand>& drawList) {
+	if (drawList.count < 2)
+		return 0;
+
+	i64 write = 0;
+	for (i64 read = 1; read < drawList.count; read++) {
+		DrawCommand& last = drawList[write];
+		DrawCommand& next = drawList[read];
+		if (CanMergeDraws(last, next)) {
+			last.numVertices += next.numVertices;
+			last.numElements += next.numElements;
+			continue;
+		}
+		drawList[++write] = next;
+	}
 
-			sg_pipeline& pipeline = GetPipeline(cmd.indexedDraw, cmd.type, true, SG_CULLMODE_NONE);
-			sg_apply_pipeline(pipeline);
+	i32 merged = (i32)(drawList.count - (write + 1));
+	drawList.count = write + 1;
+	return merged;
+}
 
-			sg_bindings bind{0};
-			bind.vertex_buffers[0] = pRenderState->transientVertexBuffer;
-			bind.fs = {
-				.images = { pRenderState->whiteTexture },
-				.samplers = { pRenderState->samplerNearest }
-			};
+// ***********************************************************************
 
-			if (cmd.texturedDraw) {
-				bind.fs.images[0] = cmd.texture;
-			}
+static const f32 resolutionSteps[] = { 1.0f, 0.75f, 0.5f };
 
-			Assert(!cmd.indexedDraw);
+void UpdateDynamicResolution(RenderStats& finished) {
+	// reused frames did no work, so they say nothing about the cost of the scene
+	if (!pRenderState->dynamicResolutionState || finished.frameReused || finished.renderTime <= 0.0f)
+		return;
 
-			sg_range vsUniforms = SG_RANGE_REF(cmd.vsUniforms);
-			sg_apply_uniforms(SG_SHADERSTAGE_VS, 0, &vsUniforms);
-			sg_range fsUniforms = SG_RANGE_REF(cmd.fsUniforms);
-			sg_apply_uniforms(SG_SHADERSTAGE_FS, 0, &fsUniforms);
+	pRenderState->renderTimes[pRenderState->renderTimeCount++] = finished.renderTime;
+	if (pRenderState->renderTimeCount < DYNAMIC_RESOLUTION_WINDOW)
+		return;
+	pRenderState->renderTimeCount = 0;
 
-			bind.vertex_buffer_offsets[0] = cmd.vertexBufferOffset;
-			sg_apply_bindings(&bind);
-			sg_draw(0, cmd.numElements, 1); 
-		}
-		sg_end_pass();
+	f32 average = 0.0f;
+	for (i32 i = 0; i < DYNAMIC_RESOLUTION_WINDOW; i++) {
+		average += pRenderState->renderTimes[i];
 	}
+	average /= DYNAMIC_RESOLUTION_WINDOW;
 
-	// Draw framebuffer to swapchain, upscaling in the process
-	{
-		sg_begin_pass(&pRenderState->passCompositor);
-		sg_apply_pipeline(pRenderState->pipeCompositor);
+	i32 step = pRenderState->resolutionStep;
+	i32 lastStep = (i32)(sizeof(resolutionSteps) / sizeof(f32)) - 1;
+	if (average > pRenderState->frameBudget && step < lastStep) {
+		step++;
+	}
+	else if (step > 0) {
+		// cost mostly follows pixel count, so guess what the bigger step would take
+		f32 ratio = resolutionSteps[step - 1] / resolutionSteps[step];
+		if (average * ratio * ratio < pRenderState->frameBudget * DYNAMIC_RESOLUTION_HEADROOM)
+			step--;
+	}
 
-		// paramaterize this, the true screen resolution
-		sg_apply_viewport(0, 0, 1280, 720, true);
-		sg_apply_scissor_rect(0, 0, 1280, 720, true);
+	// the window starts again after a change, so the new step gets a full window before it's judged
+	pRenderState->resolutionStep = step;
+	pRenderState->resolution3D.x = floorf(pRenderState->targetResolution.x * resolutionSteps[step]);
+	pRenderState->resolution3D.y = floorf(pRenderState->targetResolution.y * resolutionSteps[step]);
+}
 
-		sg_bindings bind = { 
-			.vertex_buffers = { pRenderState->fullscreenTriangle },
-			.fs = {
-				.images = { { pRenderState->fbCore2DScene }, { pRenderState->fbCore3DScene } },
-				.samplers = { { pRenderState->samplerNearest } }
-			}
-		};
-		sg_apply_bindings(&bind);
+// ***********************************************************************
+
+void RetireStaleMapChunks() {
+	pRenderState->mapFrameIndex++;
+
+	ResizableArray<MapChunk>& chunks = pRenderState->mapChunks;
+	for (i64 i = 0; i < chunks.count; i++) {
+		if (chunks[i].lastUsedFrame + MAP_CHUNK_MAX_AGE >= pRenderState->mapFrameIndex)
+			continue;
+
+		// order doesn't matter, swap with the last one
+		GpuResources::RetireBuffer(chunks[i].vertexBuffer);
+		chunks[i] = chunks[chunks.count - 1];
+		chunks.count--;
+		i--;
+	}
+}
+
+// ***********************************************************************
+
+void SubmitFrame(i32 w, i32 h) {
+	RetireStaleMapChunks();
+
+	FrameData& build = *pRenderState->pBuildFrame;
+	build.resolution3D = pRenderState->resolution3D;
+
+	// before hashing, so vram writes count as texture changes
+	Vram::CollectUploads(build.vramUploads, build.vramPixels);
+
+	build.stats.drawsMerged = MergeDrawList(build.drawList3D) + MergeDrawList(build.drawList2D);
+
+	build.clearColor = pRenderState->clearColorState;
+	build.dither = pRenderState->ditherState;
+	build.ditherPattern = pRenderState->ditherPatternState;
+
+	// the dither pass writes its own target, so its settings are part of both layers
+	u64 ditherHash = HashBytes(14695981039346656037ull, &build.dither, sizeof(build.dither));
+	ditherHash = HashBytes(ditherHash, &build.ditherPattern, sizeof(build.ditherPattern));
+	u64 hash3D = HashBytes(ditherHash, &build.clearColor, sizeof(build.clearColor));
+	hash3D = HashBytes(hash3D, &build.resolution3D, sizeof(build.resolution3D));
+	build.layerHash3D = HashDrawList(hash3D, build, build.drawList3D);
+	build.layerHash2D = HashDrawList(ditherHash, build, build.drawList2D);
+
+	// fence, wait for the render thread to finish the previous frame before we hand over this one
+	SDL_SemWait(pRenderState->pRenderIdle);
+
+	// only now is the previous frame done with its images, so the budget may evict them
+	GpuResources::NewFrame();
+	GpuResources::DestroyRetired();
+
+	pRenderState->lastFrameStats = pRenderState->pSubmitFrame->stats;
+	UpdateDynamicResolution(pRenderState->lastFrameStats);
+	pRenderState->winWidth = w;
+	pRenderState->winHeight = h;
+
+	FrameData* pFrame = pRenderState->pSubmitFrame;
+	pRenderState->pSubmitFrame = pRenderState->pBuildFrame;
+	pRenderState->pBuildFrame = pFrame;
+
+	SDL_SemPost(pRenderState->pFrameReady);
+
+	// prepare for next frame
+	pFrame->perFrameVertexBuffer.count = 0;
+	pFrame->perFramePackedVertexBuffer.count = 0;
+	pFrame->perFrameIndexBuffer.count = 0;
+	pFrame->drawList3D.count = 0;
+	pFrame->drawList2D.count = 0;
+	pFrame->occluderVerts.count = 0;
+	pFrame->vramUploads.count = 0;
+	pFrame->vramPixels.count = 0;
+	pFrame->imageUpdates.count = 0;
+	pFrame->imagePixels.count = 0;
+	pFrame->impostorBakes.count = 0;
+	pFrame->stats = RenderStats();
+
+	for (u64 i = 0; i < (int)EMatrixMode::Count; i++) {
+        pRenderState->matrixStates[i].array.count = 1;
+        pRenderState->matrixStates[i][0] = Matrixf::Identity();
+    }
+}
+
+// ***********************************************************************
+
+// Runs on the render thread, user shaders have their own fragment uniform layout
+
+void ApplyFragmentUniforms(DrawCommand& cmd) {
+	if (cmd.userShader >= 0) {
+		UserShaderParams userParams;
+		userParams.fogColor = cmd.fsUniforms.fogColor;
+		memcpy(userParams.params, cmd.shaderParams, sizeof(userParams.params));
+		sg_range fsUniforms = SG_RANGE_REF(userParams);
+		sg_apply_uniforms(SG_SHADERSTAGE_FS, 0, &fsUniforms);
+	}
+	else if (cmd.shaderVariant & (SHADER_VARIANT_FOG | SHADER_VARIANT_VRAM)) {
+		sg_range fsUniforms = SG_RANGE_REF(cmd.fsUniforms);
+		sg_apply_uniforms(SG_SHADERSTAGE_FS, 0, &fsUniforms);
+	}
+}
+
+// ***********************************************************************
+
+// Runs on the render thread, quantises a finished layer into its dither target
+
+void DrawDitherPass(sg_pass& pass, sg_image source, EDitherPattern pattern) {
+	static const f32 patternSizes[(i32)EDitherPattern::Count] = { 2.0f, 4.0f, 8.0f };
+
+	sg_begin_pass(&pass);
+	sg_apply_pipeline(pRenderState->pipeDither);
+	sg_apply_viewport(0, 0, (i32)pRenderState->targetResolution.x, (i32)pRenderState->targetResolution.y, true);
+	sg_apply_scissor_rect(0, 0, (i32)pRenderState->targetResolution.x, (i32)pRenderState->targetResolution.y, true);
+
+	sg_bindings bind = { 
+		.vertex_buffers = { pRenderState->fullscreenTriangle },
+		.fs = {
+			.images = { { source }, { pRenderState->ditherPatterns[(i32)pattern] } },
+			.samplers = { { pRenderState->samplerNearest } }
+		}
+	};
+	sg_apply_bindings(&bind);
+
+	vs_dither_params_t vsUniforms;
+	vsUniforms.mvp = Matrixf::Orthographic(0.0f, 1.0f, 0.0f, 1.0f, 0.0f, 100.0f);
+	sg_range vsUniformsRange = SG_RANGE_REF(vsUniforms);
+	sg_apply_uniforms(SG_SHADERSTAGE_VS, 0, &vsUniformsRange);
+
+	// 32 values per component is 2^5, so it's a 15 bit pixel format
+	fs_dither_params_t fsUniforms;
+	fsUniforms.ditherParams = Vec4f(32.0f, patternSizes[(i32)pattern], 0.0f, 0.0f);
+	sg_range fsUniformsRange = SG_RANGE_REF(fsUniforms);
+	sg_apply_uniforms(SG_SHADERSTAGE_FS, 0, &fsUniformsRange);
+
+	sg_draw(0, 3, 1);
+	sg_end_pass();
+}
+
+// ***********************************************************************
+
+void QueueImageUpdate(sg_image image, const u8* pPixels, i64 size) {
+	FrameData& build = *pRenderState->pBuildFrame;
+	for (i64 i = 0; i < build.imageUpdates.count; i++) {
+		ImageUpdate& update = build.imageUpdates[i];
+		if (update.image.id == image.id && update.size == size) {
+			memcpy(build.imagePixels.pData + update.offset, pPixels, size);
+			return;
+		}
+	}
+
+	ImageUpdate update;
+	update.image = image;
+	update.offset = build.imagePixels.count;
+	update.size = size;
+	build.imagePixels.Reserve(build.imagePixels.count + size);
+	memcpy(build.imagePixels.pData + build.imagePixels.count, pPixels, size);
+	build.imagePixels.count += size;
+	build.imageUpdates.PushBack(update);
+}
+
+// ***********************************************************************
+
+void ApplyImageUpdates(FrameData& frame) {
+	// render thread
+	for (i64 i = 0; i < frame.imageUpdates.count; i++) {
+		ImageUpdate& update = frame.imageUpdates[i];
+
+		// the image may have been destroyed before it got here
+		if (sg_query_image_state(update.image) != SG_RESOURCESTATE_VALID)
+			continue;
+
+		sg_image_data data = {};
+		data.subimage[0][0] = { frame.imagePixels.pData + update.offset, (size_t)update.size };
+		sg_update_image(update.image, data);
+	}
+}
+
+// ***********************************************************************
+
+// Runs on the render thread, draws each view of the mesh into its own cell along the atlas
+
+void DrawImpostorBake(ImpostorBake& bake) {
+	// the impostor may have been collected before it got here
+	if (sg_query_attachments_state(bake.attachments) != SG_RESOURCESTATE_VALID)
+		return;
+
+	sg_pass pass = {
+		.action = {
+			.colors = {
+				{ .load_action = SG_LOADACTION_CLEAR, .clear_value = { 0.0f, 0.0f, 0.0f, 0.0f } }
+			}
+		},
+		.attachments = bake.attachments
+	};
+	sg_begin_pass(&pass);
+
+	u32 shaderVariant = 0;
+	if (bake.lit) shaderVariant |= SHADER_VARIANT_LIT;
+	if (bake.texture.id != SG_INVALID_ID) shaderVariant |= SHADER_VARIANT_TEXTURED;
+	sg_apply_pipeline(GetPipeline(shaderVariant, -1, EVertexFormat::Standard, false, EPrimitiveType::Triangles, true, SG_CULLMODE_NONE));
+
+	sg_bindings bind{0};
+	bind.vertex_buffers[0] = bake.vertexBuffer;
+	if (bake.texture.id != SG_INVALID_ID) {
+		bind.fs.images[0] = bake.texture;
+		bind.fs.samplers[0] = pRenderState->samplerNearest;
+	}
+	sg_apply_bindings(&bind);
+
+	// orthographic, just fitting the bounding sphere, depth runs from the near side of it to the far side
+	f32 r = bake.radius;
+	Matrixf projection = Matrixf::Orthographic(-r, r, -r, r, -3.0f * r, r);
+	for (i32 i = 0; i < bake.views; i++) {
+		sg_apply_viewport(i * bake.resolution, 0, bake.resolution, bake.resolution, true);
+		sg_apply_scissor_rect(i * bake.resolution, 0, bake.resolution, bake.resolution, true);
+
+		// looking back at the centre from angle i around the y axis
+		f32 angle = 6.2831853f * i / bake.views;
+		Matrixf view = Matrixf::MakeRotation(-angle, Vec3f(0.0f, 1.0f, 0.0f)) * Matrixf::MakeTranslation(Vec3f(0.0f, 0.0f, 0.0f) - bake.center);
+
+		vs_core3d_params_t vsUniforms;
+		vsUniforms.mvp = projection * view;
+		vsUniforms.model = Matrixf::Identity();
+		vsUniforms.modelView = view;
+		for (i32 light = 0; light < MAX_LIGHTS; light++) {
+			vsUniforms.lightDirection[light] = bake.lightDirection[light];
+			vsUniforms.lightColor[light] = bake.lightColor[light];
+		}
+		vsUniforms.lightAmbient = bake.lightAmbient;
+		vsUniforms.targetResolution = Vec2f((f32)bake.resolution, (f32)bake.resolution);
+		vsUniforms.unpackScale = Vec4f(1.0f);
+		sg_range vsUniformsRange = SG_RANGE_REF(vsUniforms);
+		sg_apply_uniforms(SG_SHADERSTAGE_VS, 0, &vsUniformsRange);
+
+		sg_draw(0, bake.vertexCount, 1);
+	}
+	sg_end_pass();
+}
+
+// ***********************************************************************
+
+// Runs on the render thread, so must only touch the frame it's given and sokol objects
+
+void DrawFrame(FrameData& frame, i32 w, i32 h) {
+	// TODO: Sort the draw list to minimise state changes
+
+	u64 startTime = SDL_GetPerformanceCounter();
+	RenderStats& stats = frame.stats;
+	stats.resolutionScale = frame.resolution3D.y / pRenderState->targetResolution.y;
+	stats.drawCommands2D = (i32)frame.drawList2D.count;
+	stats.drawCommands3D = (i32)frame.drawList3D.count;
+	stats.drawCommands = stats.drawCommands2D + stats.drawCommands3D;
+	stats.verticesUploaded = (i32)(frame.perFrameVertexBuffer.count + frame.perFramePackedVertexBuffer.count);
+	stats.indicesUploaded = (i32)frame.perFrameIndexBuffer.count;
+
+	// even if nothing is drawn, vram and stream images have to stay in sync with the simulation side
+	Vram::ApplyUploads(frame.vramUploads, frame.vramPixels);
+	ApplyImageUpdates(frame);
+
+	// same for impostors, they have to be ready for whenever they're next drawn
+	for (i64 i = 0; i < frame.impostorBakes.count; i++) {
+		DrawImpostorBake(frame.impostorBakes[i]);
+	}
+
+	// layers that match what's already in their framebuffer don't need drawing again
+	bool redraw3D = !pRenderState->layersValid || frame.layerHash3D != pRenderState->drawnLayerHash3D;
+	bool redraw2D = !pRenderState->layersValid || frame.layerHash2D != pRenderState->drawnLayerHash2D;
+	pRenderState->layersValid = true;
+	pRenderState->drawnLayerHash3D = frame.layerHash3D;
+	pRenderState->drawnLayerHash2D = frame.layerHash2D;
+	stats.layersReused = (redraw3D ? 0 : 1) + (redraw2D ? 0 : 1);
+
+	if (!redraw3D && !redraw2D) {
+		// nothing changed, the swapchain still holds the last composited image, so just present it again
+		stats.frameReused = true;
+		sg_commit();
+		stats.sokol = sg_query_frame_stats();
+		return;
+	}
+
+	// Update the global vertex buffer
+	if (frame.perFrameVertexBuffer.count > 0) {
+		sg_range vtxData;
+		vtxData.ptr = (void*)frame.perFrameVertexBuffer.pData;
+		vtxData.size = frame.perFrameVertexBuffer.count * sizeof(VertexData);
+		sg_update_buffer(pRenderState->transientVertexBuffer, &vtxData);
+	}
+
+	if (frame.perFramePackedVertexBuffer.count > 0) {
+		sg_range vtxData;
+		vtxData.ptr = (void*)frame.perFramePackedVertexBuffer.pData;
+		vtxData.size = frame.perFramePackedVertexBuffer.count * sizeof(PackedVertexData);
+		sg_update_buffer(pRenderState->transientPackedVertexBuffer, &vtxData);
+	}
+
+	if (frame.perFrameIndexBuffer.count > 0) {
+		sg_range idxData;
+		idxData.ptr = (void*)frame.perFrameIndexBuffer.pData;
+		idxData.size = frame.perFrameIndexBuffer.count * sizeof(u16);
+		sg_update_buffer(pRenderState->transientIndexBuffer, &idxData);
+	}
+
+	// Draw 3D view into texture
+	if (redraw3D) {
+		Occlusion::RasterizeOccluders(frame.occluderVerts);
+
+		Vec4f clear = frame.clearColor;
+		pRenderState->passCore3DScene.action.colors[0].clear_value = { clear.x, clear.y, clear.z, clear.w };
+		sg_begin_pass(&pRenderState->passCore3DScene);
+
+		sg_apply_viewport(0, 0, (i32)frame.resolution3D.x, (i32)frame.resolution3D.y, true);
+		sg_apply_scissor_rect(0, 0, (i32)frame.resolution3D.x, (i32)frame.resolution3D.y, true);
+
+		u32 currentPipeline = SG_INVALID_ID;
+		for(i32 i = 0; i < frame.drawList3D.count; i++) {
+			DrawCommand& cmd = frame.drawList3D[i];
+
+			if (cmd.occlusionTest && !Occlusion::IsVisible(cmd.vsUniforms.mvp, cmd.boundsMin, cmd.boundsMax)) {
+				stats.occlusionCulled++;
+				continue;
+			}
+
+			sg_pipeline& pipeline = GetPipeline(cmd.shaderVariant, cmd.userShader, cmd.vertexFormat, cmd.indexedDraw, cmd.type, false, cmd.cullMode);
+			if (pipeline.id != currentPipeline) {
+				sg_apply_pipeline(pipeline);
+				currentPipeline = pipeline.id;
+				stats.pipelineSwitches++;
+			}
+			
+			sg_bindings bind{0};
+			bind.vertex_buffers[0] = pRenderState->transientVertexBuffer;
+
+			if (cmd.vertexFormat == EVertexFormat::Packed) {
+				bind.vertex_buffers[0] = pRenderState->transientPackedVertexBuffer;
+			}
+
+			if (cmd.vertexBuffer.id != SG_INVALID_ID) {
+				bind.vertex_buffers[0] = cmd.vertexBuffer;
+			}
+
+			if (cmd.indexedDraw) {
+				bind.index_buffer = cmd.indexBuffer.id != SG_INVALID_ID ? cmd.indexBuffer : pRenderState->transientIndexBuffer;
+				bind.index_buffer_offset = cmd.indexBufferOffset;
+			}
+
+			// untextured variants have no image slot at all
+			if (cmd.shaderVariant & (SHADER_VARIANT_TEXTURED | SHADER_VARIANT_VRAM | SHADER_VARIANT_ARRAY)) {
+				bind.fs.images[0] = cmd.texture;
+				bind.fs.samplers[0] = pRenderState->samplerNearest;
+			}
+
+			sg_range vsUniforms = SG_RANGE_REF(cmd.vsUniforms);
+			sg_apply_uniforms(SG_SHADERSTAGE_VS, 0, &vsUniforms);
+			ApplyFragmentUniforms(cmd);
+
+			bind.vertex_buffer_offsets[0] = cmd.vertexBufferOffset;
+			sg_apply_bindings(&bind);
+			stats.bindingSwitches++;
+			sg_draw(0, cmd.numElements, 1); 
+		}
+		sg_end_pass();
+
+		if (frame.dither) {
+			DrawDitherPass(pRenderState->passDither3D, pRenderState->fbCore3DScene, frame.ditherPattern);
+		}
+	}
+
+	// experimental code to readback 3D view for cpu editing
+	// ReadbackImagePixels(pRenderState->fbCore3DScene, pRenderState->pPixelsData);
+	// memset(pRenderState->pPixelsData + 8000 * 4 * sizeof(u8), 0, 640); 
+
+	// Draw 2D view into texture
+	if (redraw2D) {
+		sg_begin_pass(&pRenderState->passCore2DScene);
+
+		sg_apply_viewport(0, 0, (i32)pRenderState->targetResolution.x, (i32)pRenderState->targetResolution.y, true);
+		sg_apply_scissor_rect(0, 0, (i32)pRenderState->targetResolution.x, (i32)pRenderState->targetResolution.y, true);
+
+		u32 currentPipeline = SG_INVALID_ID;
+		for(i32 i = 0; i < frame.drawList2D.count; i++) {
+			DrawCommand& cmd = frame.drawList2D[i];
+
+			sg_pipeline& pipeline = GetPipeline(cmd.shaderVariant, cmd.userShader, cmd.vertexFormat, cmd.indexedDraw, cmd.type, true, SG_CULLMODE_NONE);
+			if (pipeline.id != currentPipeline) {
+				sg_apply_pipeline(pipeline);
+				currentPipeline = pipeline.id;
+				stats.pipelineSwitches++;
+			}
+
+			sg_bindings bind{0};
+			bind.vertex_buffers[0] = pRenderState->transientVertexBuffer;
+			if (cmd.vertexFormat == EVertexFormat::Packed) {
+				bind.vertex_buffers[0] = pRenderState->transientPackedVertexBuffer;
+			}
+			if (cmd.vertexBuffer.id != SG_INVALID_ID) {
+				bind.vertex_buffers[0] = cmd.vertexBuffer;
+			}
+
+			// untextured variants have no image slot at all
+			if (cmd.shaderVariant & (SHADER_VARIANT_TEXTURED | SHADER_VARIANT_VRAM | SHADER_VARIANT_ARRAY)) {
+				bind.fs.images[0] = cmd.texture;
+				bind.fs.samplers[0] = pRenderState->samplerNearest;
+			}
+
+			Assert(!cmd.indexedDraw);
+
+			sg_range vsUniforms = SG_RANGE_REF(cmd.vsUniforms);
+			sg_apply_uniforms(SG_SHADERSTAGE_VS, 0, &vsUniforms);
+			ApplyFragmentUniforms(cmd);
+
+			bind.vertex_buffer_offsets[0] = cmd.vertexBufferOffset;
+			sg_apply_bindings(&bind);
+			stats.bindingSwitches++;
+			sg_draw(0, cmd.numElements, 1); 
+		}
+		sg_end_pass();
+
+		if (frame.dither) {
+			DrawDitherPass(pRenderState->passDither2D, pRenderState->fbCore2DScene, frame.ditherPattern);
+		}
+	}
+
+	// Draw framebuffer to swapchain, upscaling in the process
+	{
+		sg_begin_pass(&pRenderState->passCompositor);
+		sg_apply_pipeline(pRenderState->pipeCompositor);
+
+		// paramaterize this, the true screen resolution
+		sg_apply_viewport(0, 0, 1280, 720, true);
+		sg_apply_scissor_rect(0, 0, 1280, 720, true);
+
+		sg_image layer2D = frame.dither ? pRenderState->fbDither2D : pRenderState->fbCore2DScene;
+		sg_image layer3D = frame.dither ? pRenderState->fbDither3D : pRenderState->fbCore3DScene;
+		sg_bindings bind = { 
+			.vertex_buffers = { pRenderState->fullscreenTriangle },
+			.fs = {
+				.images = { { layer2D }, { layer3D } },
+				.samplers = { { pRenderState->samplerNearest } }
+			}
+		};
+		sg_apply_bindings(&bind);
 
 		vs_compositor_params_t vsUniforms;
 		vsUniforms.mvp = Matrixf::Orthographic(0.0f, 1.0f, 0.0f, 1.0f, 0.0f, 100.0f);
@@ -521,6 +1547,7 @@ void DrawFrame(i32 w, i32 h) {
 		fs_compositor_params_t fsUniforms;
 		fsUniforms.screenResolution = Vec2f(1280, 720);
 		fsUniforms.time = f32(SDL_GetTicks()) / 1000.0f;
+		fsUniforms.core3DScale = Vec2f(frame.resolution3D.x / pRenderState->targetResolution.x, frame.resolution3D.y / pRenderState->targetResolution.y);
 		sg_range fsUniformsRange = SG_RANGE_REF(fsUniforms);
 		sg_apply_uniforms(SG_SHADERSTAGE_FS, 0, &fsUniformsRange);
 
@@ -532,53 +1559,217 @@ void DrawFrame(i32 w, i32 h) {
 
 
 	sg_commit();
-	SokolPresent();	
-	// prepare for next frame
-	pRenderState->perFrameVertexBuffer.count = 0;
-	pRenderState->perFrameIndexBuffer.count = 0;
-	pRenderState->drawList3D.count=0;
-	pRenderState->drawList2D.count = 0;
+	stats.renderTime = f32(SDL_GetPerformanceCounter() - startTime) / f32(SDL_GetPerformanceFrequency());
+	stats.sokol = sg_query_frame_stats();
+}
 
-	for (u64 i = 0; i < (int)EMatrixMode::Count; i++) {
-        pRenderState->matrixStates[i].array.count = 1;
-        pRenderState->matrixStates[i][0] = Matrixf::Identity();
-    }
+// ***********************************************************************
+
+int RenderThread(void* pUserData) {
+	while (true) {
+		SDL_SemWait(pRenderState->pFrameReady);
+		if (pRenderState->renderThreadQuit)
+			break;
+
+		SDL_LockMutex(pRenderState->pGpuLock);
+		DrawFrame(*pRenderState->pSubmitFrame, pRenderState->winWidth, pRenderState->winHeight);
+		SDL_UnlockMutex(pRenderState->pGpuLock);
+
+		// outside the lock, with vsync this blocks for most of a frame and the simulation
+		// thread would otherwise wait on it just to make a buffer
+		SokolPresent();
+
+		SDL_SemPost(pRenderState->pRenderIdle);
+	}
+	return 0;
 }
 
 // ***********************************************************************
 
-void BeginObject2D(EPrimitiveType type) {
-    pRenderState->typeState = type;
-    pRenderState->mode = ERenderMode::Mode2D;
+RenderStats GetRenderStats() {
+	return pRenderState->lastFrameStats;
 }
 
 // ***********************************************************************
 
-void EndObject2D() {
-    if (pRenderState->mode == ERenderMode::None)  // TODO Call errors when this is incorrect
-        return;
+void RecordTextureUpload(sg_image image, i64 bytes) {
+	pRenderState->pBuildFrame->stats.textureUploads++;
+	pRenderState->pBuildFrame->stats.textureUploadBytes += bytes;
 
-	DrawCommand cmd;
-	
-	cmd.type = pRenderState->typeState;
+	for (i64 i = 0; i < pRenderState->textureVersions.count; i++) {
+		if (pRenderState->textureVersions[i].imageId == image.id) {
+			pRenderState->textureVersions[i].version++;
+			return;
+		}
+	}
+	pRenderState->textureVersions.PushBack({ image.id, 1 });
+}
 
-	// fill vertex buffer
-	// TODO: this pattern is repeated, could refactor out into function such as FillTransientBuffer
-	u32 numVertices = (u32)pRenderState->vertexState.count;
-	VertexData* pDestBuffer = pRenderState->perFrameVertexBuffer.pData + pRenderState->perFrameVertexBuffer.count;
-	if (pRenderState->perFrameVertexBuffer.count + numVertices > MAX_VERTICES_PER_FRAME)
+// ***********************************************************************
+
+void ForgetTextureVersion(sg_image image) {
+	ResizableArray<TextureVersion>& versions = pRenderState->textureVersions;
+	for (i64 i = 0; i < versions.count; i++) {
+		if (versions[i].imageId == image.id) {
+			// order doesn't matter, swap with the last one
+			versions[i] = versions[versions.count - 1];
+			versions.count--;
+			return;
+		}
+	}
+}
+
+// ***********************************************************************
+
+Vec4f PackVertices(VertexData* pVertices, i32 count, PackedVertexData* pOutVertices) {
+	// find the range of the positions and uvs so they can be normalized
+	Vec3f posExtent = Vec3f(0.0f);
+	f32 texExtent = 0.0f;
+	for (i32 i = 0; i < count; i++) {
+		posExtent.x = max(posExtent.x, fabsf(pVertices[i].pos.x));
+		posExtent.y = max(posExtent.y, fabsf(pVertices[i].pos.y));
+		posExtent.z = max(posExtent.z, fabsf(pVertices[i].pos.z));
+		texExtent = max(texExtent, max(fabsf(pVertices[i].tex.x), fabsf(pVertices[i].tex.y)));
+	}
+	posExtent.x = max(posExtent.x, 0.000001f);
+	posExtent.y = max(posExtent.y, 0.000001f);
+	posExtent.z = max(posExtent.z, 0.000001f);
+	texExtent = max(texExtent, 0.000001f);
+
+	for (i32 i = 0; i < count; i++) {
+		VertexData& src = pVertices[i];
+		PackedVertexData& dst = pOutVertices[i];
+		dst.pos[0] = (i16)roundf(clamp(src.pos.x / posExtent.x, -1.0f, 1.0f) * 32767.0f);
+		dst.pos[1] = (i16)roundf(clamp(src.pos.y / posExtent.y, -1.0f, 1.0f) * 32767.0f);
+		dst.pos[2] = (i16)roundf(clamp(src.pos.z / posExtent.z, -1.0f, 1.0f) * 32767.0f);
+		dst.pos[3] = 32767;
+		dst.col[0] = (u8)roundf(clamp(src.col.x, 0.0f, 1.0f) * 255.0f);
+		dst.col[1] = (u8)roundf(clamp(src.col.y, 0.0f, 1.0f) * 255.0f);
+		dst.col[2] = (u8)roundf(clamp(src.col.z, 0.0f, 1.0f) * 255.0f);
+		dst.col[3] = (u8)roundf(clamp(src.col.w, 0.0f, 1.0f) * 255.0f);
+		dst.tex[0] = (i16)roundf(clamp(src.tex.x / texExtent, -1.0f, 1.0f) * 32767.0f);
+		dst.tex[1] = (i16)roundf(clamp(src.tex.y / texExtent, -1.0f, 1.0f) * 32767.0f);
+		dst.norm[0] = (i8)roundf(clamp(src.norm.x, -1.0f, 1.0f) * 127.0f);
+		dst.norm[1] = (i8)roundf(clamp(src.norm.y, -1.0f, 1.0f) * 127.0f);
+		dst.norm[2] = (i8)roundf(clamp(src.norm.z, -1.0f, 1.0f) * 127.0f);
+		dst.norm[3] = 0;
+	}
+	return Vec4f(posExtent.x, posExtent.y, posExtent.z, texExtent);
+}
+
+// ***********************************************************************
+
+bool FillTransientVertexBuffer(DrawCommand& cmd, VertexData* pVertices, u32 numVertices, EVertexFormat format) {
+	cmd.vertexFormat = format;
+	cmd.vsUniforms.unpackScale = Vec4f(1.0f);
+
+	if (format == EVertexFormat::Packed) {
+		ResizableArray<PackedVertexData>& buffer = pRenderState->pBuildFrame->perFramePackedVertexBuffer;
+		if (buffer.count + numVertices > MAX_PACKED_VERTICES_PER_FRAME) {
+			pRenderState->pBuildFrame->stats.vertexBufferOverflows++;
+			return false;
+		}
+		cmd.vsUniforms.unpackScale = PackVertices(pVertices, (i32)numVertices, buffer.pData + buffer.count);
+		cmd.numVertices = (i32)numVertices;
+		cmd.vertexBufferOffset = (i32)buffer.count * sizeof(PackedVertexData);
+		buffer.count += numVertices;
+		return true;
+	}
+
+	ResizableArray<VertexData>& buffer = pRenderState->pBuildFrame->perFrameVertexBuffer;
+	if (buffer.count + numVertices > MAX_VERTICES_PER_FRAME) {
+		pRenderState->pBuildFrame->stats.vertexBufferOverflows++;
+		return false;
+	}
+	memcpy(buffer.pData + buffer.count, pVertices, numVertices * sizeof(VertexData));
+	cmd.numVertices = (i32)numVertices;
+	cmd.vertexBufferOffset = (i32)buffer.count * sizeof(VertexData);
+	buffer.count += numVertices;
+	return true;
+}
+
+// ***********************************************************************
+
+bool FillTransientIndexBuffer(DrawCommand& cmd, u16* pIndices, u32 numIndices) {
+	ResizableArray<u16>& buffer = pRenderState->pBuildFrame->perFrameIndexBuffer;
+	if (buffer.count + numIndices > MAX_VERTICES_PER_FRAME) {
+		pRenderState->pBuildFrame->stats.vertexBufferOverflows++;
+		return false;
+	}
+	memcpy(buffer.pData + buffer.count, pIndices, numIndices * sizeof(u16));
+	cmd.indexBufferOffset = (i32)buffer.count * sizeof(u16);
+	buffer.count += numIndices;
+	return true;
+}
+
+// ***********************************************************************
+
+bool IsTextureArray(sg_image image) {
+	for (i64 i = 0; i < pRenderState->textureArrays.count; i++) {
+		if (pRenderState->textureArrays[i] == image.id)
+			return true;
+	}
+	return false;
+}
+
+// ***********************************************************************
+
+void ApplyTextureLayer() {
+	// shift uvs into the bound layer's band, see TEXTURE_ARRAY_LAYER_STRIDE
+	f32 offset = pRenderState->textureLayerOffsetState;
+	if (offset == 0.0f)
 		return;
-	memcpy(pDestBuffer, pRenderState->vertexState.pData, numVertices * sizeof(VertexData));
-	cmd.vertexBufferOffset = (i32)pRenderState->perFrameVertexBuffer.count * sizeof(VertexData);
-	cmd.numElements = numVertices;
-	pRenderState->perFrameVertexBuffer.count += numVertices;
 
-    // Submit draw call
+	for (i64 i = 0; i < pRenderState->vertexState.count; i++) {
+		pRenderState->vertexState[i].tex.x += offset;
+	}
+}
+
+// ***********************************************************************
+
+void SetVramState(DrawCommand& cmd) {
+	if (cmd.texturedDraw || !pRenderState->vramBoundState)
+		return;
+
+	cmd.texture = Vram::GetImage();
+	cmd.fsUniforms.vramPage = pRenderState->vramPageState;
+	cmd.fsUniforms.vramClut = pRenderState->vramClutState;
+	cmd.shaderVariant |= SHADER_VARIANT_VRAM;
+}
+
+// ***********************************************************************
+
+void SetUserShaderState(DrawCommand& cmd) {
+	cmd.userShader = pRenderState->userShaderState;
+	if (cmd.userShader < 0)
+		return;
+
+	// user shaders only read regular textures
+	cmd.shaderVariant &= ~(SHADER_VARIANT_VRAM | SHADER_VARIANT_ARRAY);
+
+	if (!cmd.texturedDraw || IsTextureArray(cmd.texture)) {
+		cmd.texture = pRenderState->whiteTexture;
+		cmd.shaderVariant |= SHADER_VARIANT_TEXTURED;
+	}
+	memcpy(cmd.shaderParams, pRenderState->shaderParamStates, sizeof(cmd.shaderParams));
+}
+
+// ***********************************************************************
+
+void BeginObject2D(EPrimitiveType type) {
+    pRenderState->typeState = type;
+    pRenderState->mode = ERenderMode::Mode2D;
+}
+
+// ***********************************************************************
+
+void SetDrawState2D(DrawCommand& cmd, sg_image texture) {
+	cmd.cullMode = SG_CULLMODE_NONE;
+
     Matrixf ortho = Matrixf::Orthographic(0.0f, pRenderState->targetResolution.x, 0.0f, pRenderState->targetResolution.y, -100.0f, 100.0f);
 	cmd.vsUniforms.mvp = ortho * pRenderState->matrixStates[(u64)EMatrixMode::Model][-1];
 	cmd.vsUniforms.model = pRenderState->matrixStates[(u64)EMatrixMode::Model][-1];
 	cmd.vsUniforms.modelView = pRenderState->matrixStates[(u64)EMatrixMode::View][-1] * pRenderState->matrixStates[(u64)EMatrixMode::Model][-1];
-	cmd.vsUniforms.lightingEnabled = 0;
 	cmd.vsUniforms.lightDirection[0] = 0.f;
 	cmd.vsUniforms.lightDirection[1] = 0.f;
 	cmd.vsUniforms.lightDirection[2] = 0.f;
@@ -587,19 +1778,45 @@ void EndObject2D() {
 	cmd.vsUniforms.lightColor[2] = 0.f;
 	cmd.vsUniforms.lightAmbient = Vec3f(0.0);
 	cmd.vsUniforms.targetResolution = pRenderState->targetResolution;
-	cmd.vsUniforms.fogEnabled = 0;
 	cmd.vsUniforms.fogDepths = Vec2f(0.0);
 	cmd.fsUniforms.fogColor = Vec4f(0.0);
+	cmd.fsUniforms.vramPage = Vec4f(0.0);
+	cmd.fsUniforms.vramClut = Vec4f(0.0);
 
 	cmd.indexedDraw = false;
 
-    if (pRenderState->textureState.id != SG_INVALID_ID) {
+    if (texture.id != SG_INVALID_ID) {
 		cmd.texturedDraw = true;
-		cmd.texture = pRenderState->textureState;
+		cmd.texture = texture;
     } else {
 		cmd.texturedDraw = false;
     }
-	pRenderState->drawList2D.PushBack(cmd);
+
+	cmd.shaderVariant = 0;
+	if (cmd.texturedDraw) cmd.shaderVariant |= IsTextureArray(texture) ? SHADER_VARIANT_ARRAY : SHADER_VARIANT_TEXTURED;
+	SetVramState(cmd);
+	SetUserShaderState(cmd);
+}
+
+// ***********************************************************************
+
+void EndObject2D() {
+    if (pRenderState->mode == ERenderMode::None)  // TODO Call errors when this is incorrect
+        return;
+
+	DrawCommand cmd;
+	cmd.type = pRenderState->typeState;
+	ApplyTextureLayer();
+
+	// fill vertex buffer
+	u32 numVertices = (u32)pRenderState->vertexState.count;
+	if (!FillTransientVertexBuffer(cmd, pRenderState->vertexState.pData, numVertices, EVertexFormat::Standard))
+		return;
+	cmd.numElements = numVertices;
+
+    // Submit draw call
+	SetDrawState2D(cmd, pRenderState->textureState);
+	pRenderState->pBuildFrame->drawList2D.PushBack(cmd);
 
     pRenderState->vertexState.count = 0;
     pRenderState->vertexColorState = Vec4f(1.0f);
@@ -618,6 +1835,39 @@ void BeginObject3D(EPrimitiveType type) {
 
 // ***********************************************************************
 
+void SetDrawState3D(DrawCommand& cmd, sg_image texture) {
+	cmd.vsUniforms.mvp = pRenderState->matrixStates[(u64)EMatrixMode::Projection][-1] * pRenderState->matrixStates[(u64)EMatrixMode::View][-1] * pRenderState->matrixStates[(u64)EMatrixMode::Model][-1];
+	cmd.vsUniforms.model = pRenderState->matrixStates[(u64)EMatrixMode::Model][-1];
+	cmd.vsUniforms.modelView = pRenderState->matrixStates[(u64)EMatrixMode::View][-1] * pRenderState->matrixStates[(u64)EMatrixMode::Model][-1];
+	cmd.vsUniforms.lightDirection[0] = pRenderState->lightDirectionsStates[0];
+	cmd.vsUniforms.lightDirection[1] = pRenderState->lightDirectionsStates[1];
+	cmd.vsUniforms.lightDirection[2] = pRenderState->lightDirectionsStates[2];
+	cmd.vsUniforms.lightColor[0] = pRenderState->lightColorStates[0];
+	cmd.vsUniforms.lightColor[1] = pRenderState->lightColorStates[1];
+	cmd.vsUniforms.lightColor[2] = pRenderState->lightColorStates[2];
+	cmd.vsUniforms.lightAmbient = pRenderState->lightAmbientState;
+	// vertices snap to the pixels of the resolution actually being drawn
+	cmd.vsUniforms.targetResolution = pRenderState->resolution3D;
+	cmd.vsUniforms.fogDepths = pRenderState->fogDepths;
+	cmd.fsUniforms.fogColor = Vec4f::Embed3D(pRenderState->fogColor);
+
+    if (texture.id != SG_INVALID_ID) {
+		cmd.texturedDraw = true;
+		cmd.texture = texture;
+    } else {
+		cmd.texturedDraw = false;
+    }
+
+	cmd.shaderVariant = 0;
+	if (pRenderState->lightingState) cmd.shaderVariant |= SHADER_VARIANT_LIT;
+	if (pRenderState->fogState) cmd.shaderVariant |= SHADER_VARIANT_FOG;
+	if (cmd.texturedDraw) cmd.shaderVariant |= IsTextureArray(texture) ? SHADER_VARIANT_ARRAY : SHADER_VARIANT_TEXTURED;
+	SetVramState(cmd);
+	SetUserShaderState(cmd);
+}
+
+// ***********************************************************************
+
 void EndObject3D() {
     if (pRenderState->mode == ERenderMode::None)  // TODO Call errors when this is incorrect
         return;
@@ -628,6 +1878,54 @@ void EndObject3D() {
 	cmd.type = pRenderState->typeState;
 	cmd.cullMode = pRenderState->cullMode;
 	bool buffersFilled = false;
+	ApplyTextureLayer();
+
+	// user provided index buffer
+	for (i64 i = 0; i < pRenderState->indexState.count; i++) {
+		if (pRenderState->indexState[i] >= pRenderState->vertexState.count) {
+			Log::Warn("Index %d is out of range, object only has %d vertices", pRenderState->indexState[i], (i32)pRenderState->vertexState.count);
+			pRenderState->vertexState.count = 0;
+			pRenderState->indexState.count = 0;
+			pRenderState->mode = ERenderMode::None;
+			return;
+		}
+	}
+
+	// bounds and occluders are taken before any normal processing rearranges the vertices
+	if (pRenderState->vertexState.count > 0) {
+		cmd.boundsMin = pRenderState->vertexState[0].pos;
+		cmd.boundsMax = pRenderState->vertexState[0].pos;
+		for (i64 i = 1; i < pRenderState->vertexState.count; i++) {
+			Vec3f pos = pRenderState->vertexState[i].pos;
+			cmd.boundsMin = Vec3f(min(cmd.boundsMin.x, pos.x), min(cmd.boundsMin.y, pos.y), min(cmd.boundsMin.z, pos.z));
+			cmd.boundsMax = Vec3f(max(cmd.boundsMax.x, pos.x), max(cmd.boundsMax.y, pos.y), max(cmd.boundsMax.z, pos.z));
+		}
+	}
+
+	if (pRenderState->occlusionCullingState) {
+		if (pRenderState->occluderState && pRenderState->typeState == EPrimitiveType::Triangles) {
+			Matrixf mvp = pRenderState->matrixStates[(u64)EMatrixMode::Projection][-1] * pRenderState->matrixStates[(u64)EMatrixMode::View][-1] * pRenderState->matrixStates[(u64)EMatrixMode::Model][-1];
+			bool indexed = pRenderState->indexState.count > 0;
+			i32 count = indexed ? (i32)pRenderState->indexState.count : (i32)pRenderState->vertexState.count;
+			Occlusion::AddOccluder(pRenderState->pBuildFrame->occluderVerts, mvp, pRenderState->vertexState.pData, indexed ? pRenderState->indexState.pData : nullptr, count - count % 3);
+		}
+		cmd.occlusionTest = !pRenderState->occluderState && pRenderState->vertexState.count > 0;
+	}
+
+	if (pRenderState->indexState.count > 0 && pRenderState->typeState == EPrimitiveType::Triangles && pRenderState->normalsModeState == ENormalsMode::Flat) {
+		// flat normals need every triangle to own its vertices, so expand the indices back out
+		ResizableArray<VertexData> expandedVerts(g_pArenaFrame);
+		expandedVerts.Reserve(pRenderState->indexState.count);
+		for (i64 i = 0; i < pRenderState->indexState.count; i++) {
+			expandedVerts.PushBack(pRenderState->vertexState[pRenderState->indexState[i]]);
+		}
+		pRenderState->vertexState.count = 0;
+		pRenderState->vertexState.Reserve(expandedVerts.count);
+		memcpy(pRenderState->vertexState.pData, expandedVerts.pData, expandedVerts.count * sizeof(VertexData));
+		pRenderState->vertexState.count = expandedVerts.count;
+		pRenderState->indexState.count = 0;
+	}
+
     switch (pRenderState->typeState) {
         case EPrimitiveType::Points:
 		case EPrimitiveType::Lines:
@@ -635,26 +1933,29 @@ void EndObject3D() {
 			break;
         case EPrimitiveType::Triangles: {
             if (pRenderState->normalsModeState == ENormalsMode::Flat) {
-                for (i64 i = 0; i < pRenderState->vertexState.count; i += 3) {
-                    Vec3f v1 = pRenderState->vertexState[i + 1].pos - pRenderState->vertexState[i].pos;
-                    Vec3f v2 = pRenderState->vertexState[i + 2].pos - pRenderState->vertexState[i].pos;
-                    Vec3f faceNormal = Vec3f::Cross(v1, v2).GetNormalized();
-
-                    pRenderState->vertexState[i].norm = faceNormal;
-                    pRenderState->vertexState[i + 1].norm = faceNormal;
-                    pRenderState->vertexState[i + 2].norm = faceNormal;
-                }
+				ComputeFlatNormals(pRenderState->vertexState.pData, pRenderState->vertexState.count);
 
 				u32 numVertices = (u32)pRenderState->vertexState.count;
-				VertexData* pDestBuffer = pRenderState->perFrameVertexBuffer.pData + pRenderState->perFrameVertexBuffer.count;
-				if (pRenderState->perFrameVertexBuffer.count + numVertices > MAX_VERTICES_PER_FRAME)
+				if (!FillTransientVertexBuffer(cmd, pRenderState->vertexState.pData, numVertices, pRenderState->vertexFormatState))
 					return;
-				memcpy(pDestBuffer, pRenderState->vertexState.pData, numVertices * sizeof(VertexData));
-
-				cmd.vertexBufferOffset = (i32)pRenderState->perFrameVertexBuffer.count * sizeof(VertexData);
 				cmd.numElements = numVertices;
-				pRenderState->perFrameVertexBuffer.count += numVertices;
 				buffersFilled = true;
+            } else if (pRenderState->normalsModeState == ENormalsMode::Smooth && pRenderState->indexState.count > 0) {
+				// vertices are already shared, so accumulate face normals through the given indices
+				ResizableArray<u16>& indices = pRenderState->indexState;
+				for (i64 i = 0; i + 2 < indices.count; i += 3) {
+                    Vec3f v1 = pRenderState->vertexState[indices[i + 1]].pos - pRenderState->vertexState[indices[i]].pos;
+                    Vec3f v2 = pRenderState->vertexState[indices[i + 2]].pos - pRenderState->vertexState[indices[i]].pos;
+                    Vec3f faceNormal = Vec3f::Cross(v1, v2);
+
+                    pRenderState->vertexState[indices[i]].norm += faceNormal;
+                    pRenderState->vertexState[indices[i + 1]].norm += faceNormal;
+                    pRenderState->vertexState[indices[i + 2]].norm += faceNormal;
+				}
+
+                for (i64 i = 0; i < pRenderState->vertexState.count; i++) {
+                    pRenderState->vertexState[i].norm = pRenderState->vertexState[i].norm.GetNormalized();
+                }
             } else if (pRenderState->normalsModeState == ENormalsMode::Smooth) {
 				// the purpose of this is to make same vertices share the same normal vector that gets averaged from the nearby polygons
                 // Convert to indexed list, loop through, saving verts into vector, each new one you search for in vector, if you find it, save index in index list.
@@ -687,79 +1988,545 @@ void EndObject3D() {
                     uniqueVerts[i].norm = uniqueVerts[i].norm.GetNormalized();
                 }
 
-                // fill vertex buffer
-				u32 numVertices = (u32)uniqueVerts.count;
-				VertexData* pDestBuffer = pRenderState->perFrameVertexBuffer.pData + pRenderState->perFrameVertexBuffer.count;
-				if (pRenderState->perFrameVertexBuffer.count + numVertices > MAX_VERTICES_PER_FRAME)
+                // fill vertex and index buffers
+				if (!FillTransientVertexBuffer(cmd, uniqueVerts.pData, (u32)uniqueVerts.count, pRenderState->vertexFormatState))
 					return;
-				memcpy(pDestBuffer, uniqueVerts.pData, numVertices * sizeof(VertexData));
-				cmd.vertexBufferOffset = (i32)pRenderState->perFrameVertexBuffer.count * sizeof(VertexData);
-				pRenderState->perFrameVertexBuffer.count += numVertices;
 
-                // fill index buffer
                 numIndices = (u32)indices.count;
-				u16* pDestIndexBuffer = pRenderState->perFrameIndexBuffer.pData + pRenderState->perFrameIndexBuffer.count;
-				if (pRenderState->perFrameIndexBuffer.count + numIndices > MAX_VERTICES_PER_FRAME)
+				if (!FillTransientIndexBuffer(cmd, indices.pData, numIndices))
 					return;
-				memcpy(pDestIndexBuffer, indices.pData, numIndices * sizeof(u16));
-				cmd.indexBufferOffset = (i32)pRenderState->perFrameIndexBuffer.count * sizeof(u16);
-				pRenderState->perFrameIndexBuffer.count += numIndices;
 
-				cmd.numElements = numIndices;
-				buffersFilled = true;
-            }
-        }
-        default:
-            break;
-    }
+				cmd.numElements = numIndices;
+				buffersFilled = true;
+            }
+        }
+        default:
+            break;
+    }
+
+    if (buffersFilled == false) {
+        // fill vertex buffer
+		u32 numVertices = (u32)pRenderState->vertexState.count;
+		if (!FillTransientVertexBuffer(cmd, pRenderState->vertexState.pData, numVertices, pRenderState->vertexFormatState))
+			return;
+		cmd.numElements = numVertices;
+
+		if (pRenderState->indexState.count > 0) {
+			numIndices = (u32)pRenderState->indexState.count;
+			if (!FillTransientIndexBuffer(cmd, pRenderState->indexState.pData, numIndices))
+				return;
+			cmd.numElements = numIndices;
+		}
+    }
+
+    if (pRenderState->indexState.count > 0)
+        cmd.indexedDraw = true;
+    else if (pRenderState->normalsModeState == ENormalsMode::Smooth && cmd.type == EPrimitiveType::Triangles)
+        cmd.indexedDraw = true;
+	else
+		cmd.indexedDraw = false;
+
+    // Submit draw call
+	SetDrawState3D(cmd, pRenderState->textureState);
+	pRenderState->pBuildFrame->drawList3D.PushBack(cmd);
+
+    pRenderState->vertexState.count = 0;
+    pRenderState->indexState.count = 0;
+    pRenderState->vertexColorState = Vec4f(1.0f);
+    pRenderState->vertexTexCoordState = Vec2f();
+    pRenderState->vertexNormalState = Vec3f();
+    pRenderState->mode = ERenderMode::None;
+}
+
+// ***********************************************************************
+
+void ComputeFlatNormals(VertexData* pVertices, i64 count) {
+	i64 triangleCount = count / 3;
+
+	// four triangles at a time, gathered out of the vertices into one register per component
+	i64 t = 0;
+	for (; t + 4 <= triangleCount; t += 4) {
+		VertexData* v = pVertices + t * 3;
+		__m128 p0x = _mm_set_ps(v[9].pos.x, v[6].pos.x, v[3].pos.x, v[0].pos.x);
+		__m128 p0y = _mm_set_ps(v[9].pos.y, v[6].pos.y, v[3].pos.y, v[0].pos.y);
+		__m128 p0z = _mm_set_ps(v[9].pos.z, v[6].pos.z, v[3].pos.z, v[0].pos.z);
+		__m128 e1x = _mm_sub_ps(_mm_set_ps(v[10].pos.x, v[7].pos.x, v[4].pos.x, v[1].pos.x), p0x);
+		__m128 e1y = _mm_sub_ps(_mm_set_ps(v[10].pos.y, v[7].pos.y, v[4].pos.y, v[1].pos.y), p0y);
+		__m128 e1z = _mm_sub_ps(_mm_set_ps(v[10].pos.z, v[7].pos.z, v[4].pos.z, v[1].pos.z), p0z);
+		__m128 e2x = _mm_sub_ps(_mm_set_ps(v[11].pos.x, v[8].pos.x, v[5].pos.x, v[2].pos.x), p0x);
+		__m128 e2y = _mm_sub_ps(_mm_set_ps(v[11].pos.y, v[8].pos.y, v[5].pos.y, v[2].pos.y), p0y);
+		__m128 e2z = _mm_sub_ps(_mm_set_ps(v[11].pos.z, v[8].pos.z, v[5].pos.z, v[2].pos.z), p0z);
+
+		__m128 nx = _mm_sub_ps(_mm_mul_ps(e1y, e2z), _mm_mul_ps(e1z, e2y));
+		__m128 ny = _mm_sub_ps(_mm_mul_ps(e1z, e2x), _mm_mul_ps(e1x, e2z));
+		__m128 nz = _mm_sub_ps(_mm_mul_ps(e1x, e2y), _mm_mul_ps(e1y, e2x));
+
+		// a full divide rather than rsqrt, so results match the scalar path exactly. Degenerate triangles get a zero normal
+		__m128 lengthSq = _mm_add_ps(_mm_add_ps(_mm_mul_ps(nx, nx), _mm_mul_ps(ny, ny)), _mm_mul_ps(nz, nz));
+		__m128 valid = _mm_cmpgt_ps(lengthSq, _mm_setzero_ps());
+		__m128 invLength = _mm_and_ps(_mm_div_ps(_mm_set1_ps(1.0f), _mm_sqrt_ps(lengthSq)), valid);
+
+		alignas(16) f32 outX[4];
+		alignas(16) f32 outY[4];
+		alignas(16) f32 outZ[4];
+		_mm_store_ps(outX, _mm_mul_ps(nx, invLength));
+		_mm_store_ps(outY, _mm_mul_ps(ny, invLength));
+		_mm_store_ps(outZ, _mm_mul_ps(nz, invLength));
+		for (i32 lane = 0; lane < 4; lane++) {
+			Vec3f normal = Vec3f(outX[lane], outY[lane], outZ[lane]);
+			v[lane * 3].norm = normal;
+			v[lane * 3 + 1].norm = normal;
+			v[lane * 3 + 2].norm = normal;
+		}
+	}
+
+	for (; t < triangleCount; t++) {
+		VertexData* v = pVertices + t * 3;
+		Vec3f faceNormal = Vec3f::Cross(v[1].pos - v[0].pos, v[2].pos - v[0].pos);
+		f32 lengthSq = Vec3f::Dot(faceNormal, faceNormal);
+		faceNormal = lengthSq > 0.0f ? faceNormal * (1.0f / sqrtf(lengthSq)) : Vec3f(0.0f, 0.0f, 0.0f);
+		v[0].norm = faceNormal;
+		v[1].norm = faceNormal;
+		v[2].norm = faceNormal;
+	}
+}
+
+// ***********************************************************************
+
+StaticMesh CreateStaticMesh(VertexData* pVertices, i32 count, UserData* pTexture, sg_image texture, bool packed) {
+	// baked in flat normals mode, the normals are worked out once here rather than every frame
+	// on a copy, since the vertices may belong to a script that still wants its own normals
+	if (pRenderState->normalsModeState == ENormalsMode::Flat) {
+		VertexData* pFlatVertices = New(g_pArenaFrame, VertexData, count);
+		memcpy(pFlatVertices, pVertices, count * sizeof(VertexData));
+		ComputeFlatNormals(pFlatVertices, count);
+		pVertices = pFlatVertices;
+	}
+
+	StaticMesh mesh;
+	mesh.format = packed ? EVertexFormat::Packed : EVertexFormat::Standard;
+	mesh.unpackScale = Vec4f(1.0f);
+	mesh.pTexture = pTexture;
+	mesh.texture = texture;
+	mesh.vertexCount = count;
+
+	mesh.boundsMin = count > 0 ? pVertices[0].pos : Vec3f();
+	mesh.boundsMax = mesh.boundsMin;
+	for (i32 i = 1; i < count; i++) {
+		Vec3f pos = pVertices[i].pos;
+		mesh.boundsMin = Vec3f(min(mesh.boundsMin.x, pos.x), min(mesh.boundsMin.y, pos.y), min(mesh.boundsMin.z, pos.z));
+		mesh.boundsMax = Vec3f(max(mesh.boundsMax.x, pos.x), max(mesh.boundsMax.y, pos.y), max(mesh.boundsMax.z, pos.z));
+	}
+
+	sg_buffer_desc vbufferDesc = {
+		.size = count * sizeof(VertexData),
+		.type = SG_BUFFERTYPE_VERTEXBUFFER,
+		.usage = SG_USAGE_IMMUTABLE,
+		.data = { pVertices, count * sizeof(VertexData) },
+		.label = "Static mesh"
+	};
+	if (packed) {
+		PackedVertexData* pPacked = New(g_pArenaFrame, PackedVertexData, count);
+		mesh.unpackScale = PackVertices(pVertices, count, pPacked);
+		vbufferDesc.size = count * sizeof(PackedVertexData);
+		vbufferDesc.data = { pPacked, count * sizeof(PackedVertexData) };
+	}
+	LockGpu();
+	mesh.vertexBuffer = sg_make_buffer(&vbufferDesc);
+	UnlockGpu();
+
+	GpuResources::TrackBuffer(mesh.vertexBuffer, (i64)vbufferDesc.size);
+	return mesh;
+}
+
+// ***********************************************************************
+
+void DestroyStaticMesh(StaticMesh& mesh) {
+	// the frame in flight may still draw it
+	GpuResources::RetireBuffer(mesh.vertexBuffer);
+	mesh.vertexBuffer.id = SG_INVALID_ID;
+	mesh.vertexCount = 0;
+}
+
+// ***********************************************************************
+
+sg_image GetStaticMeshTexture(StaticMesh& mesh) {
+	if (mesh.pTexture == nullptr) {
+		GpuResources::TouchImage(mesh.texture);
+		return mesh.texture;
+	}
+
+	// uploads it again if it was evicted or changed
+	UpdateUserDataImage(mesh.pTexture);
+	return mesh.pTexture->img;
+}
+
+// ***********************************************************************
+
+void DrawStaticMesh(StaticMesh& mesh) {
+	if (mesh.vertexBuffer.id == SG_INVALID_ID || mesh.vertexCount == 0)
+		return;
+
+	// already in world space, and normals were baked in, so this is just a flat triangle list
+	DrawCommand cmd;
+	cmd.type = EPrimitiveType::Triangles;
+	cmd.cullMode = pRenderState->cullMode;
+	cmd.vertexFormat = mesh.format;
+	cmd.vertexBuffer = mesh.vertexBuffer;
+	cmd.vertexBufferOffset = 0;
+	cmd.indexBufferOffset = 0;
+	cmd.numElements = mesh.vertexCount;
+	cmd.numVertices = mesh.vertexCount;
+	cmd.indexedDraw = false;
+	cmd.vsUniforms.unpackScale = mesh.unpackScale;
+	cmd.boundsMin = mesh.boundsMin;
+	cmd.boundsMax = mesh.boundsMax;
+	cmd.occlusionTest = pRenderState->occlusionCullingState;
+	SetDrawState3D(cmd, GetStaticMeshTexture(mesh));
+	pRenderState->pBuildFrame->drawList3D.PushBack(cmd);
+}
+
+// ***********************************************************************
+
+i64 GetTerrainSize(i32 width, i32 height) {
+	i32 chunksX = (width - 2) / TERRAIN_CHUNK_SIZE + 1;
+	i32 chunksZ = (height - 2) / TERRAIN_CHUNK_SIZE + 1;
+	return sizeof(Terrain) + chunksX * chunksZ * sizeof(TerrainChunk);
+}
+
+// ***********************************************************************
+
+f32 SampleTerrainHeight(f32* pHeights, i32 width, i32 height, f32 heightScale, i32 x, i32 z) {
+	x = clamp(x, 0, width - 1);
+	z = clamp(z, 0, height - 1);
+	return pHeights[z * width + x] * heightScale;
+}
+
+// ***********************************************************************
+
+void CreateTerrain(Terrain* pTerrain, f32* pHeights, i32 width, i32 height, f32 cellSize, f32 heightScale, f32 textureRepeat) {
+	pTerrain->chunksX = (width - 2) / TERRAIN_CHUNK_SIZE + 1;
+	pTerrain->chunksZ = (height - 2) / TERRAIN_CHUNK_SIZE + 1;
+	pTerrain->chunkLength = TERRAIN_CHUNK_SIZE * cellSize;
+	pTerrain->pChunks = (TerrainChunk*)((u8*)pTerrain + sizeof(Terrain));
+
+	const i32 row = TERRAIN_CHUNK_SIZE + 1;
+	VertexData* pVertices = New(g_pArenaFrame, VertexData, TERRAIN_CHUNK_VERTICES);
+	for (i32 cz = 0; cz < pTerrain->chunksZ; cz++) {
+		for (i32 cx = 0; cx < pTerrain->chunksX; cx++) {
+			TerrainChunk& chunk = pTerrain->pChunks[cz * pTerrain->chunksX + cx];
+			f32 minHeight = 1e30f;
+			f32 maxHeight = -1e30f;
+
+			for (i32 z = 0; z < row; z++) {
+				for (i32 x = 0; x < row; x++) {
+					// the last chunk can hang off the edge of the map, those vertices fold back onto it
+					i32 gx = min(cx * TERRAIN_CHUNK_SIZE + x, width - 1);
+					i32 gz = min(cz * TERRAIN_CHUNK_SIZE + z, height - 1);
+					f32 h = SampleTerrainHeight(pHeights, width, height, heightScale, gx, gz);
+					minHeight = min(minHeight, h);
+					maxHeight = max(maxHeight, h);
+
+					f32 slopeX = (SampleTerrainHeight(pHeights, width, height, heightScale, gx + 1, gz) - SampleTerrainHeight(pHeights, width, height, heightScale, gx - 1, gz)) / (2.0f * cellSize);
+					f32 slopeZ = (SampleTerrainHeight(pHeights, width, height, heightScale, gx, gz + 1) - SampleTerrainHeight(pHeights, width, height, heightScale, gx, gz - 1)) / (2.0f * cellSize);
+
+					VertexData& v = pVertices[z * row + x];
+					v.pos = Vec3f(gx * cellSize, h, gz * cellSize);
+					v.col = Vec4f(1.0f, 1.0f, 1.0f, 1.0f);
+					v.tex = Vec2f(textureRepeat * gx / (width - 1), textureRepeat * gz / (height - 1));
+					v.norm = Vec3f(-slopeX, 1.0f, -slopeZ).GetNormalized();
+				}
+			}
+
+			// skirts only need to reach as far as the coarsest neighbour could be off by
+			f32 skirtDepth = max(maxHeight - minHeight, cellSize * 0.1f);
+			VertexData* pSkirt = pVertices + TERRAIN_CHUNK_GRID_VERTICES;
+			for (i32 i = 0; i < row; i++) {
+				pSkirt[i] = pVertices[i];
+				pSkirt[row + i] = pVertices[TERRAIN_CHUNK_SIZE * row + i];
+				pSkirt[2 * row + i] = pVertices[i * row];
+				pSkirt[3 * row + i] = pVertices[i * row + TERRAIN_CHUNK_SIZE];
+			}
+			for (i32 i = 0; i < 4 * row; i++) {
+				pSkirt[i].pos.y -= skirtDepth;
+			}
+
+			chunk.boundsMin = Vec3f(pVertices[0].pos.x, minHeight - skirtDepth, pVertices[0].pos.z);
+			chunk.boundsMax = Vec3f(pVertices[TERRAIN_CHUNK_GRID_VERTICES - 1].pos.x, maxHeight, pVertices[TERRAIN_CHUNK_GRID_VERTICES - 1].pos.z);
+
+			sg_buffer_desc vbufferDesc = {
+				.size = TERRAIN_CHUNK_VERTICES * sizeof(VertexData),
+				.type = SG_BUFFERTYPE_VERTEXBUFFER,
+				.usage = SG_USAGE_IMMUTABLE,
+				.data = { pVertices, TERRAIN_CHUNK_VERTICES * sizeof(VertexData) },
+				.label = "Terrain chunk"
+			};
+			LockGpu();
+			chunk.vertexBuffer = sg_make_buffer(&vbufferDesc);
+			UnlockGpu();
+			GpuResources::TrackBuffer(chunk.vertexBuffer, (i64)vbufferDesc.size);
+		}
+	}
+}
+
+// ***********************************************************************
+
+void DestroyTerrain(Terrain& terrain) {
+	// the frame in flight may still draw these
+	for (i32 i = 0; i < terrain.chunksX * terrain.chunksZ; i++) {
+		GpuResources::RetireBuffer(terrain.pChunks[i].vertexBuffer);
+		terrain.pChunks[i].vertexBuffer.id = SG_INVALID_ID;
+	}
+}
+
+// ***********************************************************************
+
+bool IsBoxInFrustum(Matrixf& mvp, Vec3f boundsMin, Vec3f boundsMax) {
+	// outside if every corner is beyond the same clip plane
+	i32 outside[5] = { 0 };
+	for (i32 i = 0; i < 8; i++) {
+		Vec4f clip = mvp * Vec4f(i & 1 ? boundsMax.x : boundsMin.x, i & 2 ? boundsMax.y : boundsMin.y, i & 4 ? boundsMax.z : boundsMin.z, 1.0f);
+		outside[0] += clip.x < -clip.w;
+		outside[1] += clip.x > clip.w;
+		outside[2] += clip.y < -clip.w;
+		outside[3] += clip.y > clip.w;
+		outside[4] += clip.w <= 0.0f;
+	}
+	for (i32 i = 0; i < 5; i++) {
+		if (outside[i] == 8)
+			return false;
+	}
+	return true;
+}
+
+// ***********************************************************************
+
+void DrawTerrain(Terrain& terrain) {
+	Matrixf model = pRenderState->matrixStates[(u64)EMatrixMode::Model][-1];
+	Matrixf modelView = pRenderState->matrixStates[(u64)EMatrixMode::View][-1] * model;
+	Matrixf mvp = pRenderState->matrixStates[(u64)EMatrixMode::Projection][-1] * modelView;
+
+	// chunk length as the camera sees it, so scaled terrain picks lods the same way
+	Vec4f chunkAxis = modelView * Vec4f(terrain.chunkLength, 0.0f, 0.0f, 0.0f);
+	f32 chunkLength = sqrtf(chunkAxis.x * chunkAxis.x + chunkAxis.y * chunkAxis.y + chunkAxis.z * chunkAxis.z);
+
+	sg_image texture = pRenderState->textureState;
+	for (i32 i = 0; i < terrain.chunksX * terrain.chunksZ; i++) {
+		TerrainChunk& chunk = terrain.pChunks[i];
+		if (chunk.vertexBuffer.id == SG_INVALID_ID || !IsBoxInFrustum(mvp, chunk.boundsMin, chunk.boundsMax))
+			continue;
+
+		Vec3f center = (chunk.boundsMin + chunk.boundsMax) * 0.5f;
+		Vec4f viewCenter = modelView * Vec4f(center.x, center.y, center.z, 1.0f);
+		f32 distance = sqrtf(viewCenter.x * viewCenter.x + viewCenter.y * viewCenter.y + viewCenter.z * viewCenter.z);
+		i32 lod = 0;
+		f32 lodDistance = TERRAIN_LOD_DISTANCE * chunkLength;
+		while (lod < TERRAIN_LOD_COUNT - 1 && distance > lodDistance) {
+			lod++;
+			lodDistance *= 2.0f;
+		}
+
+		DrawCommand cmd;
+		cmd.type = EPrimitiveType::Triangles;
+		cmd.cullMode = pRenderState->cullMode;
+		cmd.vertexFormat = EVertexFormat::Standard;
+		cmd.vertexBuffer = chunk.vertexBuffer;
+		cmd.vertexBufferOffset = 0;
+		cmd.indexBuffer = pRenderState->terrainIndexBuffer;
+		cmd.indexBufferOffset = pRenderState->terrainLodOffsets[lod] * (i32)sizeof(u16);
+		cmd.numElements = pRenderState->terrainLodCounts[lod];
+		cmd.numVertices = TERRAIN_CHUNK_VERTICES;
+		cmd.indexedDraw = true;
+		cmd.vsUniforms.unpackScale = Vec4f(1.0f);
+		cmd.boundsMin = chunk.boundsMin;
+		cmd.boundsMax = chunk.boundsMax;
+		cmd.occlusionTest = pRenderState->occlusionCullingState;
+		SetDrawState3D(cmd, texture);
+		pRenderState->pBuildFrame->drawList3D.PushBack(cmd);
+	}
+	GpuResources::TouchImage(texture);
+}
+
+// ***********************************************************************
+
+void CreateImpostor(Impostor* pImpostor, VertexData* pVertices, i32 count, UserData* pTexture, i32 views, i32 resolution) {
+	pImpostor->mesh = CreateStaticMesh(pVertices, count, pTexture, sg_image { SG_INVALID_ID }, false);
+	pImpostor->views = views;
+	pImpostor->center = (pImpostor->mesh.boundsMin + pImpostor->mesh.boundsMax) * 0.5f;
+	pImpostor->radius = 0.0001f;
+	for (i32 i = 0; i < count; i++) {
+		Vec3f offset = pVertices[i].pos - pImpostor->center;
+		pImpostor->radius = max(pImpostor->radius, sqrtf(Vec3f::Dot(offset, offset)));
+	}
+
+	// same formats as the core3D target, so the core3D pipelines can draw into it
+	sg_image_desc atlasDesc = {
+		.render_target = true,
+		.width = views * resolution,
+		.height = resolution,
+		.sample_count = 1,
+		.label = "Impostor atlas"
+	};
+	LockGpu();
+	pImpostor->atlas = sg_make_image(&atlasDesc);
+	atlasDesc.pixel_format = SG_PIXELFORMAT_DEPTH;
+	atlasDesc.label = "Impostor depth";
+	pImpostor->depth = sg_make_image(&atlasDesc);
+	sg_attachments_desc attachmentsDesc = {
+		.colors = { {.image = pImpostor->atlas } },
+		.depth_stencil = { .image = pImpostor->depth }
+	};
+	pImpostor->attachments = sg_make_attachments(&attachmentsDesc);
+	UnlockGpu();
+
+	i64 atlasBytes = (i64)views * resolution * resolution * 4;
+	GpuResources::TrackImage(pImpostor->atlas, atlasBytes, nullptr);
+	GpuResources::TrackImage(pImpostor->depth, atlasBytes, nullptr);
+
+	// lit with whatever lighting is set now, the billboards themselves are drawn unlit
+	ImpostorBake bake;
+	bake.attachments = pImpostor->attachments;
+	bake.vertexBuffer = pImpostor->mesh.vertexBuffer;
+	bake.vertexCount = count;
+	bake.texture = GetStaticMeshTexture(pImpostor->mesh);
+	bake.views = views;
+	bake.resolution = resolution;
+	bake.center = pImpostor->center;
+	bake.radius = pImpostor->radius;
+	bake.lit = pRenderState->lightingState;
+	for (i32 i = 0; i < MAX_LIGHTS; i++) {
+		bake.lightDirection[i] = pRenderState->lightDirectionsStates[i];
+		bake.lightColor[i] = pRenderState->lightColorStates[i];
+	}
+	bake.lightAmbient = pRenderState->lightAmbientState;
+	pRenderState->pBuildFrame->impostorBakes.PushBack(bake);
+}
+
+// ***********************************************************************
+
+void DestroyImpostor(Impostor& impostor) {
+	// the frame in flight may still bake into or draw with these
+	DestroyStaticMesh(impostor.mesh);
+	GpuResources::RetireAttachments(impostor.attachments);
+	GpuResources::RetireImage(impostor.atlas);
+	GpuResources::RetireImage(impostor.depth);
+}
+
+// ***********************************************************************
+
+void DrawImpostor(Impostor& impostor, f32 switchDistance) {
+	Matrixf modelView = pRenderState->matrixStates[(u64)EMatrixMode::View][-1] * pRenderState->matrixStates[(u64)EMatrixMode::Model][-1];
+	Vec4f viewCenter = modelView * Vec4f(impostor.center.x, impostor.center.y, impostor.center.z, 1.0f);
+	Vec3f toCamera = Vec3f(-viewCenter.x, -viewCenter.y, -viewCenter.z);
+	if (switchDistance < 0.0f && !pRenderState->fogState) {
+		DrawStaticMesh(impostor.mesh);
+		return;
+	}
+	if (switchDistance < 0.0f)
+		switchDistance = pRenderState->fogDepths.x;
+	if (Vec3f::Dot(toCamera, toCamera) < switchDistance * switchDistance) {
+		DrawStaticMesh(impostor.mesh);
+		return;
+	}
+
+	// direction to the camera in model space, the model axes in view space are the modelView columns
+	Vec4f x = modelView * Vec4f(1.0f, 0.0f, 0.0f, 0.0f);
+	Vec4f y = modelView * Vec4f(0.0f, 1.0f, 0.0f, 0.0f);
+	Vec4f z = modelView * Vec4f(0.0f, 0.0f, 1.0f, 0.0f);
+	Vec3f axisX = Vec3f(x.x, x.y, x.z);
+	Vec3f axisY = Vec3f(y.x, y.y, y.z);
+	Vec3f axisZ = Vec3f(z.x, z.y, z.z);
+	Vec3f dir = Vec3f(Vec3f::Dot(toCamera, axisX) / Vec3f::Dot(axisX, axisX), Vec3f::Dot(toCamera, axisY) / Vec3f::Dot(axisY, axisY), Vec3f::Dot(toCamera, axisZ) / Vec3f::Dot(axisZ, axisZ));
+
+	// pick the picture taken from closest to this angle, the quad turns about y to face the camera
+	f32 step = 6.2831853f / impostor.views;
+	i32 view = (i32)floorf(atan2f(dir.x, dir.z) / step + 0.5f);
+	view = ((view % impostor.views) + impostor.views) % impostor.views;
+
+	f32 horizontal = sqrtf(dir.x * dir.x + dir.z * dir.z);
+	Vec3f right = horizontal > 0.0001f ? Vec3f(dir.z, 0.0f, -dir.x) * (1.0f / horizontal) : Vec3f(1.0f, 0.0f, 0.0f);
+	Vec3f up = Vec3f(0.0f, 1.0f, 0.0f);
+	right = right * impostor.radius;
+	up = up * impostor.radius;
+
+	f32 u0 = (f32)view / impostor.views;
+	f32 u1 = (f32)(view + 1) / impostor.views;
+	Vec4f white = Vec4f(1.0f, 1.0f, 1.0f, 1.0f);
+	Vec3f normal = Vec3f(0.0f, 0.0f, 0.0f);
+	VertexData bottomLeft = VertexData(impostor.center - right - up, white, Vec2f(u0, 1.0f), normal);
+	VertexData bottomRight = VertexData(impostor.center + right - up, white, Vec2f(u1, 1.0f), normal);
+	VertexData topRight = VertexData(impostor.center + right + up, white, Vec2f(u1, 0.0f), normal);
+	VertexData topLeft = VertexData(impostor.center - right + up, white, Vec2f(u0, 0.0f), normal);
+	VertexData vertices[6] = { bottomLeft, bottomRight, topRight, bottomLeft, topRight, topLeft };
+
+	DrawCommand cmd;
+	cmd.type = EPrimitiveType::Triangles;
+	cmd.indexBufferOffset = 0;
+	cmd.indexedDraw = false;
+	if (!FillTransientVertexBuffer(cmd, vertices, 6, EVertexFormat::Standard))
+		return;
+	cmd.numElements = 6;
+	cmd.boundsMin = impostor.center - Vec3f(impostor.radius, impostor.radius, impostor.radius);
+	cmd.boundsMax = impostor.center + Vec3f(impostor.radius, impostor.radius, impostor.radius);
+	cmd.occlusionTest = pRenderState->occlusionCullingState;
+	SetDrawState3D(cmd, impostor.atlas);
+
+	// the lighting is already in the picture
+	cmd.shaderVariant &= ~SHADER_VARIANT_LIT;
+	cmd.cullMode = SG_CULLMODE_NONE;
+	GpuResources::TouchImage(impostor.atlas);
+	pRenderState->pBuildFrame->drawList3D.PushBack(cmd);
+}
+
+// ***********************************************************************
 
-    if (buffersFilled == false) {
-        // fill vertex buffer
-		u32 numVertices = (u32)pRenderState->vertexState.count;
-		VertexData* pDestBuffer = pRenderState->perFrameVertexBuffer.pData + pRenderState->perFrameVertexBuffer.count;
-		if (pRenderState->perFrameVertexBuffer.count + numVertices > MAX_VERTICES_PER_FRAME)
-			return;
-		memcpy(pDestBuffer, pRenderState->vertexState.pData, numVertices * sizeof(VertexData));
-		cmd.vertexBufferOffset = (i32)pRenderState->perFrameVertexBuffer.count * sizeof(VertexData);
-		cmd.numElements = numVertices;
-		pRenderState->perFrameVertexBuffer.count += numVertices;
-    }
+void DrawParticles(ParticleEmitter& emitter, sg_image texture) {
+	if (emitter.count == 0)
+		return;
 
-    // Submit draw call
-	cmd.vsUniforms.mvp = pRenderState->matrixStates[(u64)EMatrixMode::Projection][-1] * pRenderState->matrixStates[(u64)EMatrixMode::View][-1] * pRenderState->matrixStates[(u64)EMatrixMode::Model][-1];
-	cmd.vsUniforms.model = pRenderState->matrixStates[(u64)EMatrixMode::Model][-1];
-	cmd.vsUniforms.modelView = pRenderState->matrixStates[(u64)EMatrixMode::View][-1] * pRenderState->matrixStates[(u64)EMatrixMode::Model][-1];
-	cmd.vsUniforms.lightingEnabled = (i32)pRenderState->lightingState;
-	cmd.vsUniforms.lightDirection[0] = pRenderState->lightDirectionsStates[0];
-	cmd.vsUniforms.lightDirection[1] = pRenderState->lightDirectionsStates[1];
-	cmd.vsUniforms.lightDirection[2] = pRenderState->lightDirectionsStates[2];
-	cmd.vsUniforms.lightColor[0] = pRenderState->lightColorStates[0];
-	cmd.vsUniforms.lightColor[1] = pRenderState->lightColorStates[1];
-	cmd.vsUniforms.lightColor[2] = pRenderState->lightColorStates[2];
-	cmd.vsUniforms.lightAmbient = pRenderState->lightAmbientState;
-	cmd.vsUniforms.targetResolution = pRenderState->targetResolution;
-	cmd.vsUniforms.fogEnabled = (i32)pRenderState->fogState;
-	cmd.vsUniforms.fogDepths = pRenderState->fogDepths;
-	cmd.fsUniforms.fogColor = Vec4f::Embed3D(pRenderState->fogColor);
+	i32 numVertices = emitter.count * 6;
+	ResizableArray<PackedVertexData>& buffer = pRenderState->pBuildFrame->perFramePackedVertexBuffer;
+	if (buffer.count + numVertices > MAX_PACKED_VERTICES_PER_FRAME) {
+		pRenderState->pBuildFrame->stats.vertexBufferOverflows++;
+		return;
+	}
 
-    if (pRenderState->normalsModeState == ENormalsMode::Smooth && cmd.type == EPrimitiveType::Triangles)
-        cmd.indexedDraw = true;
-	else
-		cmd.indexedDraw = false;
+	DrawCommand cmd;
+	cmd.type = EPrimitiveType::Triangles;
+	cmd.vertexFormat = EVertexFormat::Packed;
+	cmd.indexBufferOffset = 0;
+
+	Vec3f right = Vec3f(1.0f, 0.0f, 0.0f);
+	Vec3f up = Vec3f(0.0f, 1.0f, 0.0f);
+	if (emitter.is3D) {
+		SetDrawState3D(cmd, texture);
+
+		// billboards have no normals, lighting would only make them black
+		cmd.shaderVariant &= ~SHADER_VARIANT_LIT;
+		cmd.cullMode = SG_CULLMODE_NONE;
+
+		// the camera's axes in model space are the rows of the modelView rotation
+		Matrixf modelView = cmd.vsUniforms.modelView;
+		Vec4f x = modelView * Vec4f(1.0f, 0.0f, 0.0f, 0.0f);
+		Vec4f y = modelView * Vec4f(0.0f, 1.0f, 0.0f, 0.0f);
+		Vec4f z = modelView * Vec4f(0.0f, 0.0f, 1.0f, 0.0f);
+		right = Vec3f(x.x, y.x, z.x);
+		up = Vec3f(x.y, y.y, z.y);
+	} else {
+		SetDrawState2D(cmd, texture);
+	}
+	cmd.indexedDraw = false;
 
-    if (pRenderState->textureState.id != SG_INVALID_ID) {
-		cmd.texturedDraw = true;
-		cmd.texture = pRenderState->textureState;
-    } else {
-		cmd.texturedDraw = false;
-    }
-	pRenderState->drawList3D.PushBack(cmd);
+	cmd.vsUniforms.unpackScale = Particles::BuildBillboards(emitter, right, up, buffer.pData + buffer.count);
+	cmd.numVertices = numVertices;
+	cmd.numElements = numVertices;
+	cmd.vertexBufferOffset = (i32)buffer.count * sizeof(PackedVertexData);
+	buffer.count += numVertices;
 
-    pRenderState->vertexState.count = 0;
-    pRenderState->vertexColorState = Vec4f(1.0f);
-    pRenderState->vertexTexCoordState = Vec2f();
-    pRenderState->vertexNormalState = Vec3f();
-    pRenderState->mode = ERenderMode::None;
+	if (emitter.is3D)
+		pRenderState->pBuildFrame->drawList3D.PushBack(cmd);
+	else
+		pRenderState->pBuildFrame->drawList2D.PushBack(cmd);
 }
 
 // ***********************************************************************
@@ -776,6 +2543,14 @@ void Vertex(Vec2f vec) {
 
 // ***********************************************************************
 
+void Indices(u16* pIndices, i32 count) {
+	for (i32 i = 0; i < count; i++) {
+		pRenderState->indexState.PushBack(pIndices[i]);
+	}
+}
+
+// ***********************************************************************
+
 void Color(Vec4f col) {
     pRenderState->vertexColorState = col;
 }
@@ -800,8 +2575,14 @@ void SetCullMode(sg_cull_mode mode) {
 
 // ***********************************************************************
 
+void VertexFormat(EVertexFormat format) {
+	pRenderState->vertexFormatState = format;
+}
+
+// ***********************************************************************
+
 void SetClearColor(Vec4f color) {
-	pRenderState->passCore3DScene.action.colors[0].clear_value = { color.x, color.y, color.z, color.w }; 
+	pRenderState->clearColorState = color;
 }
 
 // ***********************************************************************
@@ -875,18 +2656,124 @@ void Identity() {
 
 // ***********************************************************************
 
+f32 GetProjectedSize(f32 radius) {
+	Matrixf modelView = pRenderState->matrixStates[(u64)EMatrixMode::View][-1] * pRenderState->matrixStates[(u64)EMatrixMode::Model][-1];
+	Matrixf& projection = pRenderState->matrixStates[(u64)EMatrixMode::Projection][-1];
+
+	// use the largest axis scale, so a scaled up model keeps its detail
+	f32 scaleSq = 0.0f;
+	for (i32 i = 0; i < 3; i++) {
+		Vec4f axis = modelView * Vec4f(i == 0 ? 1.0f : 0.0f, i == 1 ? 1.0f : 0.0f, i == 2 ? 1.0f : 0.0f, 0.0f);
+		scaleSq = max(scaleSq, axis.x * axis.x + axis.y * axis.y + axis.z * axis.z);
+	}
+
+	Vec4f center = projection * (modelView * Vec4f(0.0f, 0.0f, 0.0f, 1.0f));
+	if (center.w < 0.0001f) {
+		// at or behind the camera, treat it as filling the screen
+		return pRenderState->targetResolution.y;
+	}
+
+	// diameter in pixels is 2r * projScale / w * (height / 2)
+	f32 projScale = (projection * Vec4f(0.0f, 1.0f, 0.0f, 0.0f)).y;
+	return radius * sqrtf(scaleSq) * fabsf(projScale) / center.w * pRenderState->targetResolution.y;
+}
+
+// ***********************************************************************
+
+i32 SelectLod(f32 radius, i32 lodCount) {
+	// screen heights in pixels below which we drop to the next lod
+	static const f32 lodScreenSizes[] = { 48.0f, 24.0f, 12.0f };
+
+	f32 size = GetProjectedSize(radius);
+	i32 lod = 0;
+	while (lod < lodCount && lod < (i32)(sizeof(lodScreenSizes) / sizeof(f32)) && size < lodScreenSizes[lod]) {
+		lod++;
+	}
+	return lod;
+}
+
+// ***********************************************************************
+
 void BindTexture(sg_image image) {
     if (pRenderState->textureState.id != SG_INVALID_ID)
         UnbindTexture();
 
     // Save as current texture state for binding in endObject
     pRenderState->textureState = image;
+    pRenderState->vramBoundState = false;
+    pRenderState->textureLayerOffsetState = 0.0f;
+}
+
+// ***********************************************************************
+
+void BindTextureArray(sg_image image, i32 layer) {
+    BindTexture(image);
+    pRenderState->textureLayerOffsetState = (f32)layer * TEXTURE_ARRAY_LAYER_STRIDE;
+}
+
+// ***********************************************************************
+
+sg_image CreateTextureArray(u8** ppLayers, i32 layerCount, i32 width, i32 height) {
+	// sokol wants the slices back to back in one subimage
+	i64 layerBytes = (i64)width * height * 4;
+	u8* pPixels = New(g_pArenaFrame, u8, layerBytes * layerCount);
+	for (i32 i = 0; i < layerCount; i++) {
+		memcpy(pPixels + i * layerBytes, ppLayers[i], layerBytes);
+	}
+
+	sg_image_desc imageDesc = {
+		.type = SG_IMAGETYPE_ARRAY,
+		.width = width,
+		.height = height,
+		.num_slices = layerCount,
+		.pixel_format = SG_PIXELFORMAT_RGBA8,
+		.label = "Texture array"
+	};
+	imageDesc.data.subimage[0][0] = { pPixels, (size_t)(layerBytes * layerCount) };
+
+	LockGpu();
+	sg_image image = sg_make_image(&imageDesc);
+	UnlockGpu();
+
+	// no owner, so the budget never evicts it out from under a baked scene
+	GpuResources::TrackImage(image, layerBytes * layerCount, nullptr);
+	pRenderState->textureArrays.PushBack(image.id);
+	return image;
+}
+
+// ***********************************************************************
+
+void DestroyTextureArray(sg_image image) {
+	ResizableArray<u32>& arrays = pRenderState->textureArrays;
+	for (i64 i = 0; i < arrays.count; i++) {
+		if (arrays[i] == image.id) {
+			arrays[i] = arrays[arrays.count - 1];
+			arrays.count--;
+			break;
+		}
+	}
+
+	// may be bound in the frame the render thread is about to draw
+	GpuResources::RetireImage(image);
+}
+
+// ***********************************************************************
+
+void BindVramPage(Vec2f page, EVramMode mode, Vec2f clut) {
+    UnbindTexture();
+
+    // draws with no texture bound read from this page of vram, with uvs in texels
+    pRenderState->vramBoundState = true;
+    pRenderState->vramPageState = Vec4f(page.x, page.y, (f32)mode, 0.0f);
+    pRenderState->vramClutState = Vec4f(clut.x, clut.y, 0.0f, 0.0f);
 }
 
 // ***********************************************************************
 
 void UnbindTexture() {
     pRenderState->textureState.id = SG_INVALID_ID;
+    pRenderState->vramBoundState = false;
+    pRenderState->textureLayerOffsetState = 0.0f;
 }
 
 // ***********************************************************************
@@ -925,6 +2812,104 @@ void EnableFog(bool enabled) {
 
 // ***********************************************************************
 
+void EnableOcclusionCulling(bool enabled) {
+    pRenderState->occlusionCullingState = enabled;
+}
+
+// ***********************************************************************
+
+void EnableDynamicResolution(bool enabled, f32 frameBudget) {
+	pRenderState->dynamicResolutionState = enabled;
+	pRenderState->frameBudget = frameBudget;
+	pRenderState->renderTimeCount = 0;
+	if (!enabled) {
+		pRenderState->resolutionStep = 0;
+		pRenderState->resolution3D = pRenderState->targetResolution;
+	}
+}
+
+// ***********************************************************************
+
+void Occluder(bool enabled) {
+    pRenderState->occluderState = enabled;
+}
+
+// ***********************************************************************
+
+void EnableDither(bool enabled) {
+    pRenderState->ditherState = enabled;
+}
+
+// ***********************************************************************
+
+void SetDitherPattern(EDitherPattern pattern) {
+    pRenderState->ditherPatternState = pattern;
+}
+
+// ***********************************************************************
+
+i32 CreateUserShader(String source, String* pError) {
+	// the wrapper and backend are part of the key, so changing either recompiles
+	u64 hash = HashBytes(14695981039346656037ull, "hlsl5", 5);
+	hash = HashBytes(hash, userShaderPrefix, strlen(userShaderPrefix));
+	hash = HashBytes(hash, source.pData, source.length);
+	hash = HashBytes(hash, userShaderSuffix, strlen(userShaderSuffix));
+
+	// already made this run, i.e. the script was hot reloaded
+	for (i32 i = 0; i < (i32)pRenderState->userShaders.count; i++) {
+		if (pRenderState->userShaders[i].hash == hash)
+			return i;
+	}
+
+	UserShader userShader {};
+	userShader.hash = hash;
+
+	String cachePath = TempPrint("%s%016llx.bin", USER_SHADER_CACHE_PATH, hash);
+	if (FileExists(cachePath)) {
+		i64 size;
+		char* pBytecode = ReadWholeFile(cachePath, &size, pRenderState->pArena);
+		userShader.bytecode = { pBytecode, (size_t)size };
+	}
+	else {
+		StringBuilder builder(g_pArenaFrame);
+		builder.Append(userShaderPrefix);
+		builder.Append(source);
+		builder.Append(userShaderSuffix);
+		String fullSource = builder.CreateString(g_pArenaFrame);
+
+		u8* pBytecode;
+		i64 size;
+		if (!CompilePixelShader(fullSource, pRenderState->pArena, &pBytecode, &size, pError))
+			return -1;
+		userShader.bytecode = { pBytecode, (size_t)size };
+
+		if (!FolderExists(USER_SHADER_CACHE_PATH))
+			MakeDirectory(USER_SHADER_CACHE_PATH, true);
+		WriteWholeFile(cachePath, pBytecode, size);
+		Log::Info("Compiled user shader %S", cachePath);
+	}
+
+	// the render thread reads this list when making pipelines
+	LockGpu();
+	defer(UnlockGpu());
+	pRenderState->userShaders.PushBack(userShader);
+	return (i32)pRenderState->userShaders.count - 1;
+}
+
+// ***********************************************************************
+
+void SetShader(i32 userShader) {
+    pRenderState->userShaderState = userShader;
+}
+
+// ***********************************************************************
+
+void SetShaderParam(i32 index, Vec4f value) {
+    pRenderState->shaderParamStates[index] = value;
+}
+
+// ***********************************************************************
+
 void SetFogStart(f32 start) {
     pRenderState->fogDepths.x = start;
 }
@@ -984,3 +2969,453 @@ void DrawSpriteRect(sg_image image, Vec4f rect, Vec2f position) {
     UnbindTexture();
 }
 
+// ***********************************************************************
+
+i32 GetMapTile(u8* pTiles, bool wideTiles, i32 mapWidth, i32 x, i32 y) {
+	i64 index = (i64)y * mapWidth + x;
+	return wideTiles ? (i32)((i16*)pTiles)[index] : (i32)pTiles[index];
+}
+
+// ***********************************************************************
+
+u64 HashMapChunk(u8* pTiles, bool wideTiles, i32 mapWidth, i32 mapHeight, Vec2f tilesetSize, i32 chunkX, i32 chunkY) {
+	i32 tileBytes = wideTiles ? 2 : 1;
+	i32 x0 = chunkX * MAP_CHUNK_SIZE;
+	i32 y0 = chunkY * MAP_CHUNK_SIZE;
+	i32 rowTiles = min(MAP_CHUNK_SIZE, mapWidth - x0);
+	i32 rows = min(MAP_CHUNK_SIZE, mapHeight - y0);
+
+	// the uvs depend on the tileset layout as well as the tiles
+	u64 hash = HashBytes(14695981039346656037ull, &tilesetSize, sizeof(tilesetSize));
+	hash = HashBytes(hash, &wideTiles, sizeof(wideTiles));
+	hash = HashBytes(hash, &mapWidth, sizeof(mapWidth));
+	for (i32 y = 0; y < rows; y++) {
+		hash = HashBytes(hash, pTiles + ((i64)(y0 + y) * mapWidth + x0) * tileBytes, rowTiles * tileBytes);
+	}
+	return hash;
+}
+
+// ***********************************************************************
+
+sg_buffer BuildMapChunk(u8* pTiles, bool wideTiles, i32 mapWidth, i32 mapHeight, Vec2f tilesetSize, i32 tileSize, i32 chunkX, i32 chunkY) {
+	i32 columns = (i32)tilesetSize.x / tileSize;
+	i32 tileCount = columns * ((i32)tilesetSize.y / tileSize);
+	f32 size = (f32)tileSize;
+	Vec2f uvSize = Vec2f(size / tilesetSize.x, size / tilesetSize.y);
+	Vec4f white = Vec4f(1.0f);
+
+	// every tile gets a quad, empty ones are degenerate, so any run of tiles in a chunk row is contiguous
+	ResizableArray<VertexData> vertices(g_pArenaFrame);
+	vertices.Reserve(MAP_CHUNK_VERTICES);
+	for (i32 j = 0; j < MAP_CHUNK_SIZE; j++) {
+		for (i32 i = 0; i < MAP_CHUNK_SIZE; i++) {
+			i32 x = chunkX * MAP_CHUNK_SIZE + i;
+			i32 y = chunkY * MAP_CHUNK_SIZE + j;
+			i32 tile = (x < mapWidth && y < mapHeight) ? GetMapTile(pTiles, wideTiles, mapWidth, x, y) : 0;
+			if (tile <= 0 || tile >= tileCount) {
+				for (i32 v = 0; v < 6; v++) {
+					vertices.PushBack(VertexData(Vec3f(0.0f), white, Vec2f(0.0f), Vec3f(0.0f)));
+				}
+				continue;
+			}
+
+			Vec2f uvMin = Vec2f((tile % columns) * uvSize.x, (tile / columns) * uvSize.y);
+			Vec2f uvMax = Vec2f(uvMin.x + uvSize.x, uvMin.y + uvSize.y);
+
+			// relative to the chunk's top left corner, rows go down the screen
+			f32 left = i * size;
+			f32 right = left + size;
+			f32 top = -j * size;
+			f32 bottom = top - size;
+			vertices.PushBack(VertexData(Vec3f(left, bottom, 0.0f), white, Vec2f(uvMin.x, uvMax.y), Vec3f(0.0f)));
+			vertices.PushBack(VertexData(Vec3f(right, bottom, 0.0f), white, Vec2f(uvMax.x, uvMax.y), Vec3f(0.0f)));
+			vertices.PushBack(VertexData(Vec3f(right, top, 0.0f), white, Vec2f(uvMax.x, uvMin.y), Vec3f(0.0f)));
+			vertices.PushBack(VertexData(Vec3f(right, top, 0.0f), white, Vec2f(uvMax.x, uvMin.y), Vec3f(0.0f)));
+			vertices.PushBack(VertexData(Vec3f(left, bottom, 0.0f), white, Vec2f(uvMin.x, uvMax.y), Vec3f(0.0f)));
+			vertices.PushBack(VertexData(Vec3f(left, top, 0.0f), white, Vec2f(uvMin.x, uvMin.y), Vec3f(0.0f)));
+		}
+	}
+
+	sg_buffer_desc vbufferDesc = {
+		.size = MAP_CHUNK_VERTICES * sizeof(VertexData),
+		.type = SG_BUFFERTYPE_VERTEXBUFFER,
+		.usage = SG_USAGE_IMMUTABLE,
+		.data = { vertices.pData, MAP_CHUNK_VERTICES * sizeof(VertexData) },
+		.label = "Map chunk"
+	};
+	LockGpu();
+	sg_buffer buffer = sg_make_buffer(&vbufferDesc);
+	UnlockGpu();
+
+	GpuResources::TrackBuffer(buffer, (i64)vbufferDesc.size);
+	return buffer;
+}
+
+// ***********************************************************************
+
+MapChunk& GetMapChunk(u8* pTiles, bool wideTiles, i32 mapWidth, i32 mapHeight, sg_image tileset, Vec2f tilesetSize, i32 tileSize, i32 chunkX, i32 chunkY) {
+	ResizableArray<MapChunk>& chunks = pRenderState->mapChunks;
+
+	MapChunk* pChunk = nullptr;
+	for (i64 i = 0; i < chunks.count; i++) {
+		MapChunk& chunk = chunks[i];
+		if (chunk.pTiles == pTiles && chunk.tileset == tileset.id && chunk.tileSize == tileSize && chunk.chunkX == chunkX && chunk.chunkY == chunkY) {
+			pChunk = &chunk;
+			break;
+		}
+	}
+	if (pChunk == nullptr) {
+		MapChunk chunk;
+		chunk.pTiles = pTiles;
+		chunk.tileset = tileset.id;
+		chunk.tileSize = tileSize;
+		chunk.chunkX = chunkX;
+		chunk.chunkY = chunkY;
+		chunk.hash = 0;
+		chunk.vertexBuffer.id = SG_INVALID_ID;
+		chunks.PushBack(chunk);
+		pChunk = &chunks[chunks.count - 1];
+	}
+
+	// hashing the tiles is much cheaper than rebuilding, so only changed chunks get new buffers
+	u64 hash = HashMapChunk(pTiles, wideTiles, mapWidth, mapHeight, tilesetSize, chunkX, chunkY);
+	if (pChunk->vertexBuffer.id == SG_INVALID_ID || pChunk->hash != hash) {
+		if (pChunk->vertexBuffer.id != SG_INVALID_ID)
+			GpuResources::RetireBuffer(pChunk->vertexBuffer);
+		pChunk->vertexBuffer = BuildMapChunk(pTiles, wideTiles, mapWidth, mapHeight, tilesetSize, tileSize, chunkX, chunkY);
+		pChunk->hash = hash;
+	}
+	pChunk->lastUsedFrame = pRenderState->mapFrameIndex;
+	return *pChunk;
+}
+
+// ***********************************************************************
+
+bool IsMapRectOnScreen(Matrixf& mvp, Vec2f bottomLeft, Vec2f topRight) {
+	Vec2f clipMin = Vec2f(1.0f, 1.0f);
+	Vec2f clipMax = Vec2f(-1.0f, -1.0f);
+	for (i32 i = 0; i < 4; i++) {
+		Vec4f corner = mvp * Vec4f(i & 1 ? topRight.x : bottomLeft.x, i & 2 ? topRight.y : bottomLeft.y, 0.0f, 1.0f);
+		clipMin = Vec2f(min(clipMin.x, corner.x), min(clipMin.y, corner.y));
+		clipMax = Vec2f(max(clipMax.x, corner.x), max(clipMax.y, corner.y));
+	}
+	return clipMax.x >= -1.0f && clipMin.x <= 1.0f && clipMax.y >= -1.0f && clipMin.y <= 1.0f;
+}
+
+// ***********************************************************************
+
+void DrawMap(u8* pTiles, bool wideTiles, i32 mapWidth, i32 mapHeight, sg_image tileset, Vec2f tilesetSize, i32 tileSize, i32 cellX, i32 cellY, i32 width, i32 height, Vec2f position) {
+	if (tileSize <= 0 || tileset.id == SG_INVALID_ID)
+		return;
+
+	// the window of cells to draw, clipped to the map
+	i32 x0 = max(cellX, 0);
+	i32 y0 = max(cellY, 0);
+	i32 x1 = min(cellX + width, mapWidth);
+	i32 y1 = min(cellY + height, mapHeight);
+	if (x0 >= x1 || y0 >= y1)
+		return;
+
+	f32 size = (f32)tileSize;
+	Matrixf ortho = Matrixf::Orthographic(0.0f, pRenderState->targetResolution.x, 0.0f, pRenderState->targetResolution.y, -100.0f, 100.0f);
+	Matrixf model = pRenderState->matrixStates[(u64)EMatrixMode::Model][-1];
+	Matrixf mvp = ortho * model;
+
+	BindTexture(tileset);
+	for (i32 chunkY = y0 / MAP_CHUNK_SIZE; chunkY <= (y1 - 1) / MAP_CHUNK_SIZE; chunkY++) {
+		for (i32 chunkX = x0 / MAP_CHUNK_SIZE; chunkX <= (x1 - 1) / MAP_CHUNK_SIZE; chunkX++) {
+			// the part of this chunk inside the window, in tiles relative to the chunk
+			i32 i0 = max(x0 - chunkX * MAP_CHUNK_SIZE, 0);
+			i32 j0 = max(y0 - chunkY * MAP_CHUNK_SIZE, 0);
+			i32 i1 = min(x1 - chunkX * MAP_CHUNK_SIZE, MAP_CHUNK_SIZE);
+			i32 j1 = min(y1 - chunkY * MAP_CHUNK_SIZE, MAP_CHUNK_SIZE);
+
+			// position is the top left corner of cell (cellX, cellY)
+			Vec2f origin = Vec2f(position.x + (chunkX * MAP_CHUNK_SIZE - cellX) * size, position.y - (chunkY * MAP_CHUNK_SIZE - cellY) * size);
+			Vec2f bottomLeft = Vec2f(origin.x + i0 * size, origin.y - j1 * size);
+			Vec2f topRight = Vec2f(origin.x + i1 * size, origin.y - j0 * size);
+			if (!IsMapRectOnScreen(mvp, bottomLeft, topRight))
+				continue;
+
+			MapChunk& chunk = GetMapChunk(pTiles, wideTiles, mapWidth, mapHeight, tileset, tilesetSize, tileSize, chunkX, chunkY);
+
+			DrawCommand cmd;
+			cmd.type = EPrimitiveType::Triangles;
+			cmd.vertexFormat = EVertexFormat::Standard;
+			cmd.vertexBuffer = chunk.vertexBuffer;
+			cmd.indexBufferOffset = 0;
+			cmd.vsUniforms.unpackScale = Vec4f(1.0f);
+			SetDrawState2D(cmd, tileset);
+			Matrixf translation = Matrixf::MakeTranslation(Vec3f(origin.x, origin.y, 0.0f));
+			cmd.vsUniforms.mvp = mvp * translation;
+			cmd.vsUniforms.model = model * translation;
+
+			// whole rows are contiguous, so chunks fully inside the window are a single draw,
+			// ones cut by the window's sides need a draw per row
+			bool wholeRows = i0 == 0 && i1 == MAP_CHUNK_SIZE;
+			for (i32 j = j0; j < j1; j++) {
+				i32 firstVertex = (j * MAP_CHUNK_SIZE + i0) * 6;
+				cmd.vertexBufferOffset = firstVertex * sizeof(VertexData);
+				cmd.numVertices = wholeRows ? (j1 - j0) * MAP_CHUNK_SIZE * 6 : (i1 - i0) * 6;
+				cmd.numElements = cmd.numVertices;
+				pRenderState->pBuildFrame->drawList2D.PushBack(cmd);
+				if (wholeRows)
+					break;
+			}
+		}
+	}
+	UnbindTexture();
+}
+
+// ***********************************************************************
+
+// GP0 style packet submission. Packets are tightly packed little endian 32 bit words,
+// the top byte of the first word is the opcode and the low 24 bits a 0xBBGGRR colour.
+// Positions are two i16s (x low), uvs are two u8s in texels with the clut or texture
+// page in the top 16 bits, using the ps1's bit layouts. Consecutive packets with the
+// same state are merged into one draw.
+
+struct PacketRun {
+	EPrimitiveType type;
+	bool textured;
+	u32 page;
+	u32 clut;
+	i64 firstVertex;
+};
+
+// ***********************************************************************
+
+i32 GetPacketSize(u32 opcode) {
+	if (opcode == 0x00 || opcode == 0xE1)
+		return 1;
+
+	if (opcode >= 0x20 && opcode < 0x40) {
+		i32 corners = (opcode & 0x08) ? 4 : 3;
+		i32 size = 1 + corners;
+		if (opcode & 0x10) size += corners - 1;
+		if (opcode & 0x04) size += corners;
+		return size;
+	}
+
+	if (opcode >= 0x40 && opcode < 0x60) {
+		// polylines are terminated rather than sized, not supported
+		if (opcode & 0x08)
+			return 0;
+		return (opcode & 0x10) ? 4 : 3;
+	}
+
+	if (opcode >= 0x60 && opcode < 0x80) {
+		i32 size = 2;
+		if (opcode & 0x04) size++;
+		if (((opcode >> 3) & 3) == 0) size++;
+		return size;
+	}
+	return 0;
+}
+
+// ***********************************************************************
+
+Vec4f GetPacketColor(u32 word, bool textured, bool raw) {
+	if (raw)
+		return Vec4f(1.0f);
+
+	// like the ps1, textured colours are centered on 0x80 so they can brighten
+	f32 scale = textured ? 1.0f / 128.0f : 1.0f / 255.0f;
+	return Vec4f((f32)(word & 0xff) * scale, (f32)((word >> 8) & 0xff) * scale, (f32)((word >> 16) & 0xff) * scale, 1.0f);
+}
+
+// ***********************************************************************
+
+Vec3f GetPacketPosition(u32 word) {
+	return Vec3f((f32)(i16)(word & 0xffff), (f32)(i16)(word >> 16), 0.0f);
+}
+
+// ***********************************************************************
+
+void FlushPacketRun(PacketRun& run) {
+	ResizableArray<VertexData>& buffer = pRenderState->pBuildFrame->perFrameVertexBuffer;
+	i64 numVertices = buffer.count - run.firstVertex;
+	if (numVertices == 0)
+		return;
+
+	// drive the same state the script would have set up
+	if (run.textured) {
+		Vec2f page = Vec2f((f32)((run.page & 15) * 64), (f32)(((run.page >> 4) & 1) * 256));
+		Vec2f clut = Vec2f((f32)((run.clut & 63) * 16), (f32)((run.clut >> 6) & 511));
+		u32 mode = (run.page >> 7) & 3;
+		BindVramPage(page, mode == 0 ? EVramMode::Clut4 : mode == 1 ? EVramMode::Clut8 : EVramMode::Direct15, clut);
+	}
+	else {
+		UnbindTexture();
+	}
+
+	DrawCommand cmd;
+	cmd.type = run.type;
+	cmd.vertexFormat = EVertexFormat::Standard;
+	cmd.vsUniforms.unpackScale = Vec4f(1.0f);
+	cmd.numVertices = (i32)numVertices;
+	cmd.numElements = (i32)numVertices;
+	cmd.vertexBufferOffset = (i32)run.firstVertex * sizeof(VertexData);
+	SetDrawState2D(cmd, pRenderState->textureState);
+	pRenderState->pBuildFrame->drawList2D.PushBack(cmd);
+
+	run.firstVertex = buffer.count;
+}
+
+// ***********************************************************************
+
+void EmitPacketVertices(PacketRun& run, EPrimitiveType type, bool textured, u32 page, u32 clut, VertexData* pVertices, i32 count) {
+	ResizableArray<VertexData>& buffer = pRenderState->pBuildFrame->perFrameVertexBuffer;
+
+	// untextured draws don't care which page is set
+	if (!textured) {
+		page = 0;
+		clut = 0;
+	}
+	if (type != run.type || textured != run.textured || page != run.page || clut != run.clut) {
+		FlushPacketRun(run);
+		run.type = type;
+		run.textured = textured;
+		run.page = page;
+		run.clut = clut;
+	}
+
+	if (buffer.count + count > MAX_VERTICES_PER_FRAME) {
+		pRenderState->pBuildFrame->stats.vertexBufferOverflows++;
+		return;
+	}
+	memcpy(buffer.pData + buffer.count, pVertices, count * sizeof(VertexData));
+	buffer.count += count;
+}
+
+// ***********************************************************************
+
+bool ParsePackets(PacketRun& run, u32* pWords, i64 wordCount, i32 packetCount, String* pError) {
+	// the page sprites use, set by 0xE1 or the last textured polygon like the ps1's draw mode
+	u32 drawPage = 0;
+
+	i64 cursor = 0;
+	for (i32 i = 0; i < packetCount; i++) {
+		if (cursor >= wordCount) {
+			*pError = TempPrint("Packet %d starts past the end of the buffer", i);
+			return false;
+		}
+
+		u32* pPacket = pWords + cursor;
+		u32 opcode = pPacket[0] >> 24;
+		i32 size = GetPacketSize(opcode);
+		if (size == 0) {
+			*pError = TempPrint("Packet %d has unsupported opcode 0x%02x", i, opcode);
+			return false;
+		}
+		if (cursor + size > wordCount) {
+			*pError = TempPrint("Packet %d with opcode 0x%02x runs past the end of the buffer", i, opcode);
+			return false;
+		}
+		cursor += size;
+
+		VertexData vertices[6];
+		if (opcode >= 0x20 && opcode < 0x40) {
+			// polygons
+			bool gouraud = (opcode & 0x10) != 0;
+			bool textured = (opcode & 0x04) != 0;
+			bool raw = textured && (opcode & 0x01) != 0;
+			i32 corners = (opcode & 0x08) ? 4 : 3;
+
+			u32 page = 0;
+			u32 clut = 0;
+			i32 word = 1;
+			for (i32 c = 0; c < corners; c++) {
+				u32 color = (c == 0 || !gouraud) ? pPacket[0] : pPacket[word++];
+				u32 position = pPacket[word++];
+				u32 uv = textured ? pPacket[word++] : 0;
+				if (c == 0) clut = uv >> 16;
+				if (c == 1) page = uv >> 16;
+
+				vertices[c] = VertexData(GetPacketPosition(position), GetPacketColor(color, textured, raw), Vec2f((f32)(uv & 0xff), (f32)((uv >> 8) & 0xff)), Vec3f());
+			}
+			if (textured)
+				drawPage = page;
+
+			// quads are strips, so the second triangle is 1, 3, 2
+			if (corners == 4) {
+				vertices[4] = vertices[3];
+				vertices[3] = vertices[1];
+				vertices[5] = vertices[2];
+			}
+			EmitPacketVertices(run, EPrimitiveType::Triangles, textured, page, clut, vertices, corners == 4 ? 6 : 3);
+		}
+		else if (opcode >= 0x40 && opcode < 0x60) {
+			// lines
+			bool gouraud = (opcode & 0x10) != 0;
+			u32 endColor = gouraud ? pPacket[2] : pPacket[0];
+			u32 endPosition = gouraud ? pPacket[3] : pPacket[2];
+			vertices[0] = VertexData(GetPacketPosition(pPacket[1]), GetPacketColor(pPacket[0], false, false), Vec2f(), Vec3f());
+			vertices[1] = VertexData(GetPacketPosition(endPosition), GetPacketColor(endColor, false, false), Vec2f(), Vec3f());
+			EmitPacketVertices(run, EPrimitiveType::Lines, false, 0, 0, vertices, 2);
+		}
+		else if (opcode >= 0x60 && opcode < 0x80) {
+			// rectangles and sprites
+			bool textured = (opcode & 0x04) != 0;
+			bool raw = textured && (opcode & 0x01) != 0;
+			u32 uv = textured ? pPacket[2] : 0;
+
+			f32 width;
+			f32 height;
+			switch ((opcode >> 3) & 3) {
+				case 1: width = height = 1.0f; break;
+				case 2: width = height = 8.0f; break;
+				case 3: width = height = 16.0f; break;
+				default: {
+					u32 sizeWord = pPacket[size - 1];
+					width = (f32)(sizeWord & 0x3ff);
+					height = (f32)((sizeWord >> 16) & 0x1ff);
+					break;
+				}
+			}
+
+			// same orientation as draw_sprite, the top row of texels is at the top of the screen
+			Vec3f pos = GetPacketPosition(pPacket[1]);
+			Vec4f color = GetPacketColor(pPacket[0], textured, raw);
+			f32 u = (f32)(uv & 0xff);
+			f32 v = (f32)((uv >> 8) & 0xff);
+			vertices[0] = VertexData(pos, color, Vec2f(u, v + height), Vec3f());
+			vertices[1] = VertexData(pos + Vec3f(width, 0.0f, 0.0f), color, Vec2f(u + width, v + height), Vec3f());
+			vertices[2] = VertexData(pos + Vec3f(width, height, 0.0f), color, Vec2f(u + width, v), Vec3f());
+			vertices[3] = vertices[0];
+			vertices[4] = vertices[2];
+			vertices[5] = VertexData(pos + Vec3f(0.0f, height, 0.0f), color, Vec2f(u, v), Vec3f());
+			EmitPacketVertices(run, EPrimitiveType::Triangles, textured, drawPage, uv >> 16, vertices, 6);
+		}
+		else if (opcode == 0xE1) {
+			drawPage = pPacket[0] & 0xffff;
+		}
+	}
+	return true;
+}
+
+// ***********************************************************************
+
+bool SubmitPackets(u32* pWords, i64 wordCount, i32 packetCount, String* pError) {
+	// packets set the texture state themselves, so put the script's back afterwards
+	sg_image texture = pRenderState->textureState;
+	bool vramBound = pRenderState->vramBoundState;
+	Vec4f vramPage = pRenderState->vramPageState;
+	Vec4f vramClut = pRenderState->vramClutState;
+
+	PacketRun run;
+	run.type = EPrimitiveType::Triangles;
+	run.textured = false;
+	run.page = 0;
+	run.clut = 0;
+	run.firstVertex = pRenderState->pBuildFrame->perFrameVertexBuffer.count;
+
+	bool result = ParsePackets(run, pWords, wordCount, packetCount, pError);
+	FlushPacketRun(run);
+
+	pRenderState->textureState = texture;
+	pRenderState->vramBoundState = vramBound;
+	pRenderState->vramPageState = vramPage;
+	pRenderState->vramClutState = vramClut;
+	return result;
+}
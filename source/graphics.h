@@ -2,8 +2,15 @@
 
 #pragma once
 
+struct UserData;
+
 #define MAX_TEXTURES 8
 #define MAX_LIGHTS 3
+#define MAX_SHADER_PARAMS 4
+
+// texture array layers are stored in the integer part of u, in steps of this, so uvs
+// drawn with an array must stay within [-8, 8), this matches the ARRAY path in core3d.shader
+#define TEXTURE_ARRAY_LAYER_STRIDE 16.0f
 
 enum class ERenderMode {
     Mode2D,
@@ -33,6 +40,26 @@ enum class ENormalsMode {
     Smooth
 };
 
+enum class EDitherPattern {
+    Bayer2,
+    Bayer4,
+    Bayer8,
+    Count
+};
+
+// How a vram texture page is read, clut modes index a palette stored elsewhere in vram
+enum class EVramMode {
+    Clut4,
+    Clut8,
+    Direct15
+};
+
+enum class EVertexFormat {
+    Standard,
+    Packed,
+    Count
+};
+
 struct VertexData {
     Vec3f pos;
     Vec4f col;
@@ -48,12 +75,62 @@ struct VertexData {
     }
 };
 
+// Compact vertex layout, 20 bytes instead of 48. Positions and uvs are normalized
+// int16s that the vertex shader rescales using the draw's unpack scale
+struct PackedVertexData {
+	i16 pos[4];
+	u8 col[4];
+	i16 tex[2];
+	i8 norm[4];
+};
+
+// Counters for the cost of a single frame, reset after every SubmitFrame
+struct RenderStats {
+	i32 drawCommands;
+	i32 drawCommands2D;
+	i32 drawCommands3D;
+	i32 verticesUploaded;
+	i32 indicesUploaded;
+	i32 pipelineSwitches;
+	i32 bindingSwitches;
+	i32 textureUploads;
+	i64 textureUploadBytes;
+	i32 vertexBufferOverflows;
+	i32 occlusionCulled;
+	i32 drawsMerged;
+	i32 layersReused;
+	bool frameReused;
+
+	// render thread time for the frame, not counting present, and the 3D scale it was drawn at
+	f32 renderTime;
+	f32 resolutionScale;
+
+	// backend counters as reported by sokol, read after sg_commit so they cover this same frame
+	sg_frame_stats sokol;
+};
+
 struct Image;
 struct SDL_Window;
 struct Font;
 
 void GraphicsInit(SDL_Window* pWindow, i32 winWidth, i32 winHeight);
-void DrawFrame(i32 w, i32 h);
+void GraphicsShutdown();
+void SubmitFrame(i32 w, i32 h);
+void LockGpu();
+void UnlockGpu();
+
+// New contents for a stream image, copied now and uploaded by the render thread before it draws the frame
+// being built, so the frame still in flight keeps sampling the old ones. Later updates this frame replace earlier ones
+void QueueImageUpdate(sg_image image, const u8* pPixels, i64 size);
+
+// fnv1a style hash taking a word per step, start with 14695981039346656037 and chain calls to hash several pieces of data
+u64 HashBytes(u64 hash, const void* pData, u64 size);
+
+// Stats
+RenderStats GetRenderStats();
+void RecordTextureUpload(sg_image image, i64 bytes);
+// Drops the upload count kept for frame reuse, for when the image is going away
+void ForgetTextureVersion(sg_image image);
 
 // Basic draw 2D
 void BeginObject2D(EPrimitiveType type);
@@ -64,10 +141,75 @@ void Vertex(Vec2f vec);
 void BeginObject3D(EPrimitiveType type);
 void EndObject3D();
 void Vertex(Vec3f vec);
+void Indices(u16* pIndices, i32 count);
+
+// pTexture is the script's texture, its image is looked up whenever the mesh is drawn since it may be
+// evicted or recreated. Otherwise texture is used as is, and belongs to whoever made the mesh
+struct StaticMesh {
+	sg_buffer vertexBuffer;
+	EVertexFormat format;
+	Vec4f unpackScale;
+	UserData* pTexture;
+	sg_image texture;
+	i32 vertexCount;
+	Vec3f boundsMin;
+	Vec3f boundsMax;
+};
+
+// Face normals for a triangle list, degenerate triangles get a zero normal
+void ComputeFlatNormals(VertexData* pVertices, i64 count);
+
+// Packed meshes are quantised once here with PackVertices, the precision is relative to the mesh's extent from the origin
+StaticMesh CreateStaticMesh(VertexData* pVertices, i32 count, UserData* pTexture, sg_image texture, bool packed);
+void DestroyStaticMesh(StaticMesh& mesh);
+void DrawStaticMesh(StaticMesh& mesh);
+
+// Heightmap terrain, split into square chunks that each keep their own vertex buffer.
+// Chunk and heightmap data sit in one block after the Terrain, see GetTerrainSize
+struct TerrainChunk {
+	sg_buffer vertexBuffer;
+	Vec3f boundsMin;
+	Vec3f boundsMax;
+};
+
+struct Terrain {
+	i32 chunksX;
+	i32 chunksZ;
+	f32 chunkLength;
+	TerrainChunk* pChunks;
+};
+
+i64 GetTerrainSize(i32 width, i32 height);
+void CreateTerrain(Terrain* pTerrain, f32* pHeights, i32 width, i32 height, f32 cellSize, f32 heightScale, f32 textureRepeat);
+void DestroyTerrain(Terrain& terrain);
+void DrawTerrain(Terrain& terrain);
+
+// A mesh along with pictures of it from evenly spaced angles around the y axis. Up close the mesh
+// is drawn, further away a camera facing billboard with the nearest picture stands in for it
+struct Impostor {
+	StaticMesh mesh;
+	sg_image atlas;
+	sg_image depth;
+	sg_attachments attachments;
+	i32 views;
+	Vec3f center;
+	f32 radius;
+};
+
+void CreateImpostor(Impostor* pImpostor, VertexData* pVertices, i32 count, UserData* pTexture, i32 views, i32 resolution);
+void DestroyImpostor(Impostor& impostor);
+// A negative switch distance switches at the fog start, or never if fog is off
+void DrawImpostor(Impostor& impostor, f32 switchDistance);
+
+// Billboards for every live particle as one packed draw, in the 3D layer facing the camera or in the 2D layer
+struct ParticleEmitter;
+void DrawParticles(ParticleEmitter& emitter, sg_image texture);
 void Color(Vec4f col);
 void TexCoord(Vec2f tex);
 void Normal(Vec3f norm);
 void SetCullMode(sg_cull_mode mode);
+void VertexFormat(EVertexFormat format);
+Vec4f PackVertices(VertexData* pVertices, i32 count, PackedVertexData* pOutVertices);
 
 void SetClearColor(Vec4f color);
 
@@ -82,9 +224,17 @@ void Scale(Vec3f scaling);
 void Identity();
 void LoadMatrix(Matrixf mat);
 Matrixf GetMatrix();
+f32 GetProjectedSize(f32 radius);
+i32 SelectLod(f32 radius, i32 lodCount);
 
 // Texturing
 void BindTexture(sg_image image);
+
+// Same sized RGBA8 images stacked into one texture, draws that only differ by layer can be merged
+sg_image CreateTextureArray(u8** ppLayers, i32 layerCount, i32 width, i32 height);
+void DestroyTextureArray(sg_image image);
+void BindTextureArray(sg_image image, i32 layer);
+void BindVramPage(Vec2f page, EVramMode mode, Vec2f clut);
 void UnbindTexture();
 
 // Lighting
@@ -95,6 +245,16 @@ void Ambient(Vec3f color);
 
 // Depth Cueing
 void EnableFog(bool enabled);
+void EnableDither(bool enabled);
+void SetDitherPattern(EDitherPattern pattern);
+
+// User pixel shaders, returns -1 and fills pError if the source doesn't compile
+i32 CreateUserShader(String source, String* pError);
+void SetShader(i32 userShader);
+void SetShaderParam(i32 index, Vec4f value);
+void EnableOcclusionCulling(bool enabled);
+void EnableDynamicResolution(bool enabled, f32 frameBudget);
+void Occluder(bool enabled);
 void SetFogStart(f32 start);
 void SetFogEnd(f32 end);
 void SetFogColor(Vec3f color);
@@ -103,6 +263,14 @@ void SetFogColor(Vec3f color);
 // @todo: will be replaced with 2D rendering api
 void DrawSprite(sg_image image, Vec2f position);
 void DrawSpriteRect(sg_image image, Vec4f rect, Vec2f position);
+
+// Draws a window of a tile map with its top left corner at position. Tiles are row major u8 or i16 (wideTiles)
+// indices into the tileset, counting left to right then top to bottom, 0 is empty. Chunks of the map are baked
+// into retained buffers keyed by pTiles, and only rebuilt when their tiles change
+void DrawMap(u8* pTiles, bool wideTiles, i32 mapWidth, i32 mapHeight, sg_image tileset, Vec2f tilesetSize, i32 tileSize, i32 cellX, i32 cellY, i32 width, i32 height, Vec2f position);
+
+// Draws a buffer of ps1 GP0 style packets into the 2D layer, false and fills pError if it's malformed
+bool SubmitPackets(u32* pWords, i64 wordCount, i32 packetCount, String* pError);
 void DrawText(const char* text, Vec2f position, f32 size);
 void DrawTextEx(const char* text, Vec2f position, Vec4f color, Font* pFont, f32 size);
 void DrawPixel(Vec2f position, Vec4f color);
@@ -15,3 +15,6 @@ void SokolPresent();
 // Platform specific implementations of things
 void ReadbackImagePixels(sg_image img_id, void* pixels);
 void ReadbackPixels(int x, int y, int w, int h, void *pixels);
+sg_image CreatePartialUpdateImage(int width, int height, sg_pixel_format format, void* pInitialData);
+void UpdateImageRegion(sg_image image, int x, int y, int width, int height, void* pData, int rowPitch);
+bool CompilePixelShader(String source, Arena* pArena, u8** ppBytecode, i64* pBytecodeSize, String* pError);
@@ -25,6 +25,8 @@ bool GraphicsBackendInit(SDL_Window* pWindow, int width, int height) {
 	// Create DirectX device
 	DXGI_SWAP_CHAIN_DESC scd = {0};
 	scd.BufferCount = 1;
+	// keep the back buffer contents after present, so unchanged frames can be presented again without redrawing
+	scd.SwapEffect = DXGI_SWAP_EFFECT_SEQUENTIAL;
 	scd.BufferDesc.Format = DXGI_FORMAT_R8G8B8A8_UNORM;
 	scd.BufferDesc.RefreshRate.Numerator = 60;
 	scd.BufferDesc.RefreshRate.Denominator = 1;
@@ -248,6 +250,113 @@ void ReadbackPixels(int x, int y, int w, int h, void *pixels) {
     if(staging_tex) _sg_d3d11_Release(staging_tex);
 }
 
+// ***********************************************************************
+
+sg_image CreatePartialUpdateImage(int width, int height, sg_pixel_format format, void* pInitialData) {
+	// sokol's updatable images are dynamic, which can only be rewritten whole, so make
+	// a default usage texture ourselves and hand it to sokol
+	D3D11_TEXTURE2D_DESC texDesc = {
+		.Width = (UINT)width,
+		.Height = (UINT)height,
+		.MipLevels = 1,
+		.ArraySize = 1,
+		.Format = _sg_d3d11_texture_pixel_format(format),
+		.SampleDesc = {.Count = 1, .Quality = 0 },
+		.Usage = D3D11_USAGE_DEFAULT,
+		.BindFlags = D3D11_BIND_SHADER_RESOURCE,
+	};
+	D3D11_SUBRESOURCE_DATA initialData = {
+		.pSysMem = pInitialData,
+		.SysMemPitch = (UINT)(width * _sg_pixelformat_bytesize(format)),
+	};
+	ID3D11Texture2D* pTexture = nullptr;
+	if (FAILED(pDevice->CreateTexture2D(&texDesc, &initialData, &pTexture))) {
+		return sg_image { SG_INVALID_ID };
+	}
+
+	D3D11_SHADER_RESOURCE_VIEW_DESC srvDesc = {
+		.Format = _sg_d3d11_srv_pixel_format(format),
+		.ViewDimension = D3D11_SRV_DIMENSION_TEXTURE2D,
+	};
+	srvDesc.Texture2D.MipLevels = 1;
+	ID3D11ShaderResourceView* pView = nullptr;
+	pDevice->CreateShaderResourceView((ID3D11Resource*)pTexture, &srvDesc, &pView);
+
+	sg_image_desc imageDesc = {
+		.width = width,
+		.height = height,
+		.pixel_format = format,
+		.d3d11_texture = pTexture,
+		.d3d11_shader_resource_view = pView,
+	};
+	sg_image image = sg_make_image(&imageDesc);
+
+	// sokol holds its own references now
+	pView->Release();
+	pTexture->Release();
+	return image;
+}
+
+// ***********************************************************************
+
+void UpdateImageRegion(sg_image image, int x, int y, int width, int height, void* pData, int rowPitch) {
+	_sg_image_t* img = _sg_lookup_image(&_sg.pools, image.id);
+	if (img == nullptr)
+		return;
+
+	D3D11_BOX box = {
+		.left = (UINT)x,
+		.top = (UINT)y,
+		.front = 0,
+		.right = (UINT)(x + width),
+		.bottom = (UINT)(y + height),
+		.back = 1
+	};
+	_sg.d3d11.ctx->UpdateSubresource((ID3D11Resource*)img->d3d11.tex2d, 0, &box, pData, (UINT)rowPitch, 0);
+}
+
+// ***********************************************************************
+
+bool CompilePixelShader(String source, Arena* pArena, u8** ppBytecode, i64* pBytecodeSize, String* pError) {
+	// sokol already knows how to find the compiler dll, so borrow it rather than linking our own
+	if (!_sg_d3d11_load_d3dcompiler_dll()) {
+		*pError = String("Failed to load d3dcompiler_47.dll");
+		return false;
+	}
+
+	ID3DBlob* pOutput = nullptr;
+	ID3DBlob* pErrors = nullptr;
+	HRESULT hr = _sg.d3d11.D3DCompile_func(
+		source.pData,
+		source.length,
+		"user_shader",
+		nullptr,
+		nullptr,
+		"main",
+		"ps_5_0",
+		D3DCOMPILE_PACK_MATRIX_COLUMN_MAJOR | D3DCOMPILE_OPTIMIZATION_LEVEL3,
+		0,
+		&pOutput,
+		&pErrors);
+
+	if (FAILED(hr)) {
+		if (pErrors)
+			*pError = TempPrint("%s", (const char*)_sg_d3d11_GetBufferPointer(pErrors));
+		else
+			*pError = String("Unknown shader compile error");
+		if (pErrors) _sg_d3d11_Release(pErrors);
+		if (pOutput) _sg_d3d11_Release(pOutput);
+		return false;
+	}
+	if (pErrors) _sg_d3d11_Release(pErrors);
+
+	i64 size = (i64)_sg_d3d11_GetBufferSize(pOutput);
+	*ppBytecode = New(pArena, u8, size);
+	memcpy(*ppBytecode, _sg_d3d11_GetBufferPointer(pOutput), size);
+	*pBytecodeSize = size;
+	_sg_d3d11_Release(pOutput);
+	return true;
+}
 
 
 // FOR future reference/porting work, here is a metal and opengl implementation from here: 
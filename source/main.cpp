@@ -31,6 +31,10 @@
 #include <stdarg.h>
 #include <ctype.h>
 #include <stdint.h>
+#include <xmmintrin.h>
+#include <emmintrin.h>
+#include <immintrin.h>
+#include <intrin.h>
 
 // common_lib
 #include "common_lib.h"
@@ -82,28 +86,38 @@
 #include "bind_graphics.h"
 #include "bind_input.h"
 #include "userdata.h"
+#include "userdata_kernels.h"
 #include "cpu.h"
 #include "graphics.h"
 #include "graphics_platform.h"
+#include "gpu_resources.h"
 #include "input.h"
+#include "occlusion.h"
+#include "particles.h"
 #include "rect_packing.h"
 #include "serialization.h"
 #include "shapes.h"
 #include "virtual_filesystem.h"
+#include "vram.h"
 
 // code
 #include "asset_importer.cpp"
 #include "bind_graphics.cpp"
 #include "bind_input.cpp"
 #include "userdata.cpp"
+#include "userdata_kernels.cpp"
 #include "cpu.cpp"
 #include "graphics.cpp"
 #include "graphics_platform_d3d11.cpp"
+#include "gpu_resources.cpp"
 #include "input.cpp"
+#include "occlusion.cpp"
+#include "particles.cpp"
 #include "rect_packing.cpp"
 #include "serialization.cpp"
 #include "shapes.cpp"
 #include "virtual_filesystem.cpp"
+#include "vram.cpp"
 
 
 // ***********************************************************************
@@ -269,7 +283,9 @@ int main(int argc, char* argv[]) {
 
 			AssetImporter::AssetImportTable* pImportTable = AssetImporter::LoadImportTable(projectName);
 
-			i32 result = AssetImporter::ImportFile(pArena, format, sourceFile, outputFile);
+			// keep whatever options the import table already has for this asset
+			AssetImporter::ImportOptions options = pImportTable->table[sourceFile].options;
+			i32 result = AssetImporter::ImportFile(pArena, format, sourceFile, outputFile, options);
 			if (result >= 0) {
 				Log::Info("Import succeeded");
 
@@ -278,7 +294,8 @@ int main(int argc, char* argv[]) {
 					.outputPath = outputFile,
 					.enableAutoImport = true,
 					.lastImportTime = GetFileLastWriteTime(sourceFileHdl),
-					.importFormat = format
+					.importFormat = format,
+					.options = options
 				};
 				CloseFile(sourceFileHdl);
 
@@ -378,7 +395,8 @@ int main(int argc, char* argv[]) {
 
 		Cpu::Tick(deltaTime);
 
-		DrawFrame(winWidth, winHeight);
+		// hands this frame to the render thread, and waits for it to finish the previous one
+		SubmitFrame(winWidth, winHeight);
 
 		deltaTime = f32(SDL_GetPerformanceCounter() - frameStart) / SDL_GetPerformanceFrequency();
 
@@ -386,6 +404,7 @@ int main(int argc, char* argv[]) {
 		ArenaReset(g_pArenaFrame);
 	}
 
+	GraphicsShutdown();
 	ReportMemoryUsage();
 
 	Cpu::Close();
@@ -0,0 +1,184 @@
+// Copyright 2020-2022 David Colson. All rights reserved.
+
+// CPU occlusion culling. Occluder triangles are rasterized into a small depth buffer,
+// then draws test their bounding box against it before we submit them to the gpu.
+// Depth is clip space w (i.e. view distance), so this doesn't care about the projection conventions.
+// Everything is conservative, occluders write the furthest depth of each triangle, and
+// anything crossing the near plane is left alone.
+
+namespace Occlusion {
+
+#define OCCLUSION_NEAR 0.0001f
+#define OCCLUSION_FAR 1e30f
+
+struct OcclusionState {
+	f32* pDepth;
+	bool hasOccluders;
+};
+
+static OcclusionState* pOcclusionState;
+
+// ***********************************************************************
+
+void Init(Arena* pArena) {
+	pOcclusionState = New(pArena, OcclusionState);
+	pOcclusionState->pDepth = New(pArena, f32, OCCLUSION_BUFFER_WIDTH * OCCLUSION_BUFFER_HEIGHT);
+	pOcclusionState->hasOccluders = false;
+}
+
+// ***********************************************************************
+
+// occluders are collected with the rest of the frame, so this is called on the simulation thread
+
+void AddOccluder(ResizableArray<Vec4f>& verts, Matrixf mvp, VertexData* pVertices, u16* pIndices, i32 count) {
+	verts.Reserve(verts.count + count);
+	for (i32 i = 0; i < count; i++) {
+		Vec3f pos = pIndices ? pVertices[pIndices[i]].pos : pVertices[i].pos;
+		verts.PushBack(mvp * Vec4f(pos.x, pos.y, pos.z, 1.0f));
+	}
+}
+
+// ***********************************************************************
+
+Vec2f ToBufferSpace(Vec4f clip) {
+	f32 invW = 1.0f / clip.w;
+	return Vec2f(
+		(clip.x * invW * 0.5f + 0.5f) * OCCLUSION_BUFFER_WIDTH,
+		(clip.y * invW * 0.5f + 0.5f) * OCCLUSION_BUFFER_HEIGHT);
+}
+
+// ***********************************************************************
+
+void RasterizeTriangle(Vec4f c0, Vec4f c1, Vec4f c2) {
+	if (c0.w < OCCLUSION_NEAR || c1.w < OCCLUSION_NEAR || c2.w < OCCLUSION_NEAR)
+		return;
+
+	Vec2f p0 = ToBufferSpace(c0);
+	Vec2f p1 = ToBufferSpace(c1);
+	Vec2f p2 = ToBufferSpace(c2);
+
+	// occluders are solid, so accept either winding
+	f32 area = (p1.x - p0.x) * (p2.y - p0.y) - (p1.y - p0.y) * (p2.x - p0.x);
+	if (fabsf(area) < 0.000001f)
+		return;
+	if (area < 0.0f) {
+		Vec2f temp = p1;
+		p1 = p2;
+		p2 = temp;
+	}
+
+	i32 minX = max((i32)floorf(min(p0.x, min(p1.x, p2.x))), 0);
+	i32 maxX = min((i32)ceilf(max(p0.x, max(p1.x, p2.x))), OCCLUSION_BUFFER_WIDTH - 1);
+	i32 minY = max((i32)floorf(min(p0.y, min(p1.y, p2.y))), 0);
+	i32 maxY = min((i32)ceilf(max(p0.y, max(p1.y, p2.y))), OCCLUSION_BUFFER_HEIGHT - 1);
+	if (minX > maxX || minY > maxY)
+		return;
+
+	// edge functions, e(x, y) = a*x + b*y + c, positive inside
+	f32 a0 = p1.y - p2.y, b0 = p2.x - p1.x, k0 = p1.x * p2.y - p1.y * p2.x;
+	f32 a1 = p2.y - p0.y, b1 = p0.x - p2.x, k1 = p2.x * p0.y - p2.y * p0.x;
+	f32 a2 = p0.y - p1.y, b2 = p1.x - p0.x, k2 = p0.x * p1.y - p0.y * p1.x;
+
+	__m128 depth = _mm_set1_ps(max(c0.w, max(c1.w, c2.w)));
+	__m128 zero = _mm_setzero_ps();
+	__m128 laneOffsets = _mm_set_ps(3.5f, 2.5f, 1.5f, 0.5f);
+	__m128 minXs = _mm_set1_ps((f32)minX);
+	__m128 maxXs = _mm_set1_ps((f32)maxX + 1.0f);
+
+	// buffer width is a multiple of 4, so aligning the start column keeps us in the row
+	i32 startX = minX & ~3;
+	for (i32 y = minY; y <= maxY; y++) {
+		__m128 py = _mm_set1_ps((f32)y + 0.5f);
+		__m128 rowE0 = _mm_add_ps(_mm_mul_ps(_mm_set1_ps(b0), py), _mm_set1_ps(k0));
+		__m128 rowE1 = _mm_add_ps(_mm_mul_ps(_mm_set1_ps(b1), py), _mm_set1_ps(k1));
+		__m128 rowE2 = _mm_add_ps(_mm_mul_ps(_mm_set1_ps(b2), py), _mm_set1_ps(k2));
+
+		f32* pRow = pOcclusionState->pDepth + y * OCCLUSION_BUFFER_WIDTH;
+		for (i32 x = startX; x <= maxX; x += 4) {
+			__m128 px = _mm_add_ps(_mm_set1_ps((f32)x), laneOffsets);
+			__m128 e0 = _mm_add_ps(_mm_mul_ps(_mm_set1_ps(a0), px), rowE0);
+			__m128 e1 = _mm_add_ps(_mm_mul_ps(_mm_set1_ps(a1), px), rowE1);
+			__m128 e2 = _mm_add_ps(_mm_mul_ps(_mm_set1_ps(a2), px), rowE2);
+
+			__m128 inside = _mm_and_ps(_mm_and_ps(_mm_cmpge_ps(e0, zero), _mm_cmpge_ps(e1, zero)), _mm_cmpge_ps(e2, zero));
+			inside = _mm_and_ps(inside, _mm_and_ps(_mm_cmpge_ps(px, minXs), _mm_cmplt_ps(px, maxXs)));
+			if (_mm_movemask_ps(inside) == 0)
+				continue;
+
+			__m128 current = _mm_loadu_ps(pRow + x);
+			__m128 closer = _mm_min_ps(current, depth);
+			_mm_storeu_ps(pRow + x, _mm_or_ps(_mm_and_ps(inside, closer), _mm_andnot_ps(inside, current)));
+		}
+	}
+}
+
+// ***********************************************************************
+
+void RasterizeOccluders(ResizableArray<Vec4f>& verts) {
+	pOcclusionState->hasOccluders = verts.count > 0;
+	if (!pOcclusionState->hasOccluders)
+		return;
+
+	__m128 cleared = _mm_set1_ps(OCCLUSION_FAR);
+	for (i32 i = 0; i < OCCLUSION_BUFFER_WIDTH * OCCLUSION_BUFFER_HEIGHT; i += 4) {
+		_mm_storeu_ps(pOcclusionState->pDepth + i, cleared);
+	}
+
+	for (i64 i = 0; i + 2 < verts.count; i += 3) {
+		RasterizeTriangle(verts[i], verts[i + 1], verts[i + 2]);
+	}
+}
+
+// ***********************************************************************
+
+bool IsVisible(Matrixf mvp, Vec3f boundsMin, Vec3f boundsMax) {
+	if (!pOcclusionState->hasOccluders)
+		return true;
+
+	Vec2f rectMin = Vec2f(OCCLUSION_FAR, OCCLUSION_FAR);
+	Vec2f rectMax = Vec2f(-OCCLUSION_FAR, -OCCLUSION_FAR);
+	f32 nearestDepth = OCCLUSION_FAR;
+	for (i32 i = 0; i < 8; i++) {
+		Vec3f corner = Vec3f(
+			(i & 1) ? boundsMax.x : boundsMin.x,
+			(i & 2) ? boundsMax.y : boundsMin.y,
+			(i & 4) ? boundsMax.z : boundsMin.z);
+		Vec4f clip = mvp * Vec4f(corner.x, corner.y, corner.z, 1.0f);
+		if (clip.w < OCCLUSION_NEAR)
+			return true; // crosses the camera, just draw it
+
+		Vec2f p = ToBufferSpace(clip);
+		rectMin = Vec2f(min(rectMin.x, p.x), min(rectMin.y, p.y));
+		rectMax = Vec2f(max(rectMax.x, p.x), max(rectMax.y, p.y));
+		nearestDepth = min(nearestDepth, clip.w);
+	}
+
+	i32 minX = max((i32)floorf(rectMin.x), 0);
+	i32 maxX = min((i32)ceilf(rectMax.x), OCCLUSION_BUFFER_WIDTH - 1);
+	i32 minY = max((i32)floorf(rectMin.y), 0);
+	i32 maxY = min((i32)ceilf(rectMax.y), OCCLUSION_BUFFER_HEIGHT - 1);
+	if (minX > maxX || minY > maxY)
+		return true; // off screen, that's not our job
+
+	__m128 depth = _mm_set1_ps(nearestDepth);
+	__m128 laneOffsets = _mm_set_ps(3.0f, 2.0f, 1.0f, 0.0f);
+	__m128 minXs = _mm_set1_ps((f32)minX);
+	__m128 maxXs = _mm_set1_ps((f32)maxX);
+
+	i32 startX = minX & ~3;
+	for (i32 y = minY; y <= maxY; y++) {
+		f32* pRow = pOcclusionState->pDepth + y * OCCLUSION_BUFFER_WIDTH;
+		for (i32 x = startX; x <= maxX; x += 4) {
+			__m128 px = _mm_add_ps(_mm_set1_ps((f32)x), laneOffsets);
+			__m128 inRect = _mm_and_ps(_mm_cmpge_ps(px, minXs), _mm_cmple_ps(px, maxXs));
+
+			// any pixel where the box is in front of the occluders means it might be seen
+			__m128 visible = _mm_and_ps(inRect, _mm_cmple_ps(depth, _mm_loadu_ps(pRow + x)));
+			if (_mm_movemask_ps(visible) != 0)
+				return true;
+		}
+	}
+	return false;
+}
+
+}
@@ -0,0 +1,15 @@
+// Copyright 2020-2022 David Colson. All rights reserved.
+
+#pragma once
+
+#define OCCLUSION_BUFFER_WIDTH 80
+#define OCCLUSION_BUFFER_HEIGHT 60
+
+namespace Occlusion {
+
+void Init(Arena* pArena);
+void AddOccluder(ResizableArray<Vec4f>& occluderVerts, Matrixf mvp, VertexData* pVertices, u16* pIndices, i32 count);
+void RasterizeOccluders(ResizableArray<Vec4f>& occluderVerts);
+bool IsVisible(Matrixf mvp, Vec3f boundsMin, Vec3f boundsMax);
+
+}
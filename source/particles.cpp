@@ -0,0 +1,305 @@
+// Copyright 2020-2022 David Colson. All rights reserved.
+
+// Native particles. Each emitter keeps its particles as a structure of arrays so the
+// integration runs four particles per instruction, and billboards are written straight
+// out as packed vertices, so one emitter is a single draw however many particles it has.
+
+namespace Particles {
+
+#define PARTICLE_ARRAY_COUNT 13
+
+// ***********************************************************************
+
+i32 RoundCapacity(i32 capacity) {
+	capacity = clamp(capacity, PARTICLE_LANES, MAX_PARTICLES_PER_EMITTER);
+	return (capacity + PARTICLE_LANES - 1) & ~(PARTICLE_LANES - 1);
+}
+
+// ***********************************************************************
+
+i64 GetEmitterSize(i32 capacity) {
+	// extra lane's worth so the arrays can start 16 byte aligned
+	return sizeof(ParticleEmitter) + PARTICLE_LANES * sizeof(f32) + (i64)PARTICLE_ARRAY_COUNT * RoundCapacity(capacity) * sizeof(f32);
+}
+
+// ***********************************************************************
+
+void InitEmitter(ParticleEmitter* pEmitter, i32 capacity, bool is3D) {
+	capacity = RoundCapacity(capacity);
+	memset(pEmitter, 0, sizeof(ParticleEmitter));
+	pEmitter->capacity = capacity;
+	pEmitter->count = 0;
+	pEmitter->is3D = is3D;
+
+	pEmitter->velocityMin = Vec3f(-10.0f, -10.0f, -10.0f);
+	pEmitter->velocityMax = Vec3f(10.0f, 10.0f, 10.0f);
+	pEmitter->lifeMin = 1.0f;
+	pEmitter->lifeMax = 1.0f;
+	pEmitter->startColor = Vec4f(1.0f);
+	pEmitter->endColor = Vec4f(1.0f, 1.0f, 1.0f, 0.0f);
+	pEmitter->startSize = 1.0f;
+	pEmitter->endSize = 1.0f;
+	pEmitter->randomState = 0x9E3779B9u;
+
+	uintptr_t arrays = ((uintptr_t)pEmitter + sizeof(ParticleEmitter) + 15) & ~(uintptr_t)15;
+	f32** ppArrays[PARTICLE_ARRAY_COUNT] = {
+		&pEmitter->pPosX, &pEmitter->pPosY, &pEmitter->pPosZ,
+		&pEmitter->pVelX, &pEmitter->pVelY, &pEmitter->pVelZ,
+		&pEmitter->pAge, &pEmitter->pInvLife,
+		&pEmitter->pColorR, &pEmitter->pColorG, &pEmitter->pColorB, &pEmitter->pColorA,
+		&pEmitter->pSize
+	};
+	for (i32 i = 0; i < PARTICLE_ARRAY_COUNT; i++) {
+		*ppArrays[i] = (f32*)arrays + (i64)i * capacity;
+		memset(*ppArrays[i], 0, capacity * sizeof(f32));
+	}
+}
+
+// ***********************************************************************
+
+f32 RandomFloat(u32& state) {
+	// xorshift32, plenty for particles
+	state ^= state << 13;
+	state ^= state >> 17;
+	state ^= state << 5;
+	return (f32)(state >> 8) * (1.0f / 16777216.0f);
+}
+
+// ***********************************************************************
+
+void Emit(ParticleEmitter& emitter, i32 count) {
+	count = min(count, emitter.capacity - emitter.count);
+	if (count <= 0)
+		return;
+
+	// fresh particles extend the bounds the billboards are packed in
+	if (emitter.count == 0) {
+		emitter.boundsMin = emitter.position;
+		emitter.boundsMax = emitter.position;
+	}
+
+	u32& rng = emitter.randomState;
+	for (i32 n = 0; n < count; n++) {
+		i32 i = emitter.count++;
+		Vec3f pos;
+		pos.x = emitter.position.x + (RandomFloat(rng) * 2.0f - 1.0f) * emitter.positionSpread.x;
+		pos.y = emitter.position.y + (RandomFloat(rng) * 2.0f - 1.0f) * emitter.positionSpread.y;
+		pos.z = emitter.position.z + (RandomFloat(rng) * 2.0f - 1.0f) * emitter.positionSpread.z;
+		emitter.pPosX[i] = pos.x;
+		emitter.pPosY[i] = pos.y;
+		emitter.pPosZ[i] = emitter.is3D ? pos.z : 0.0f;
+		emitter.pVelX[i] = emitter.velocityMin.x + (emitter.velocityMax.x - emitter.velocityMin.x) * RandomFloat(rng);
+		emitter.pVelY[i] = emitter.velocityMin.y + (emitter.velocityMax.y - emitter.velocityMin.y) * RandomFloat(rng);
+		emitter.pVelZ[i] = emitter.is3D ? emitter.velocityMin.z + (emitter.velocityMax.z - emitter.velocityMin.z) * RandomFloat(rng) : 0.0f;
+
+		f32 life = emitter.lifeMin + (emitter.lifeMax - emitter.lifeMin) * RandomFloat(rng);
+		emitter.pAge[i] = 0.0f;
+		emitter.pInvLife[i] = 1.0f / max(life, 0.0001f);
+		emitter.pColorR[i] = emitter.startColor.x;
+		emitter.pColorG[i] = emitter.startColor.y;
+		emitter.pColorB[i] = emitter.startColor.z;
+		emitter.pColorA[i] = emitter.startColor.w;
+		emitter.pSize[i] = emitter.startSize;
+
+		emitter.boundsMin = Vec3f(min(emitter.boundsMin.x, pos.x), min(emitter.boundsMin.y, pos.y), min(emitter.boundsMin.z, emitter.pPosZ[i]));
+		emitter.boundsMax = Vec3f(max(emitter.boundsMax.x, pos.x), max(emitter.boundsMax.y, pos.y), max(emitter.boundsMax.z, emitter.pPosZ[i]));
+	}
+}
+
+// ***********************************************************************
+
+void Integrate(ParticleEmitter& emitter, f32 deltaTime) {
+	__m128 dt = _mm_set1_ps(deltaTime);
+	__m128 one = _mm_set1_ps(1.0f);
+	__m128 drag = _mm_set1_ps(max(1.0f - emitter.drag * deltaTime, 0.0f));
+	__m128 gravityX = _mm_set1_ps(emitter.gravity.x * deltaTime);
+	__m128 gravityY = _mm_set1_ps(emitter.gravity.y * deltaTime);
+	__m128 gravityZ = _mm_set1_ps(emitter.is3D ? emitter.gravity.z * deltaTime : 0.0f);
+
+	__m128 startR = _mm_set1_ps(emitter.startColor.x);
+	__m128 startG = _mm_set1_ps(emitter.startColor.y);
+	__m128 startB = _mm_set1_ps(emitter.startColor.z);
+	__m128 startA = _mm_set1_ps(emitter.startColor.w);
+	__m128 deltaR = _mm_set1_ps(emitter.endColor.x - emitter.startColor.x);
+	__m128 deltaG = _mm_set1_ps(emitter.endColor.y - emitter.startColor.y);
+	__m128 deltaB = _mm_set1_ps(emitter.endColor.z - emitter.startColor.z);
+	__m128 deltaA = _mm_set1_ps(emitter.endColor.w - emitter.startColor.w);
+	__m128 startSize = _mm_set1_ps(emitter.startSize);
+	__m128 deltaSize = _mm_set1_ps(emitter.endSize - emitter.startSize);
+
+	// lanes past the live count hold stale particles, keep them out of the bounds
+	__m128 laneIndices = _mm_set_ps(3.0f, 2.0f, 1.0f, 0.0f);
+	__m128 liveCount = _mm_set1_ps((f32)emitter.count);
+	__m128 minX = _mm_set1_ps(1e30f), minY = minX, minZ = minX;
+	__m128 maxX = _mm_set1_ps(-1e30f), maxY = maxX, maxZ = maxX;
+
+	// capacity is a multiple of the lane count, so the tail group never reads past the arrays
+	for (i32 i = 0; i < emitter.count; i += PARTICLE_LANES) {
+		__m128 vx = _mm_mul_ps(_mm_add_ps(_mm_load_ps(emitter.pVelX + i), gravityX), drag);
+		__m128 vy = _mm_mul_ps(_mm_add_ps(_mm_load_ps(emitter.pVelY + i), gravityY), drag);
+		__m128 vz = _mm_mul_ps(_mm_add_ps(_mm_load_ps(emitter.pVelZ + i), gravityZ), drag);
+		_mm_store_ps(emitter.pVelX + i, vx);
+		_mm_store_ps(emitter.pVelY + i, vy);
+		_mm_store_ps(emitter.pVelZ + i, vz);
+
+		__m128 px = _mm_add_ps(_mm_load_ps(emitter.pPosX + i), _mm_mul_ps(vx, dt));
+		__m128 py = _mm_add_ps(_mm_load_ps(emitter.pPosY + i), _mm_mul_ps(vy, dt));
+		__m128 pz = _mm_add_ps(_mm_load_ps(emitter.pPosZ + i), _mm_mul_ps(vz, dt));
+		_mm_store_ps(emitter.pPosX + i, px);
+		_mm_store_ps(emitter.pPosY + i, py);
+		_mm_store_ps(emitter.pPosZ + i, pz);
+
+		__m128 age = _mm_add_ps(_mm_load_ps(emitter.pAge + i), dt);
+		_mm_store_ps(emitter.pAge + i, age);
+		__m128 t = _mm_min_ps(_mm_mul_ps(age, _mm_load_ps(emitter.pInvLife + i)), one);
+
+		_mm_store_ps(emitter.pColorR + i, _mm_add_ps(startR, _mm_mul_ps(deltaR, t)));
+		_mm_store_ps(emitter.pColorG + i, _mm_add_ps(startG, _mm_mul_ps(deltaG, t)));
+		_mm_store_ps(emitter.pColorB + i, _mm_add_ps(startB, _mm_mul_ps(deltaB, t)));
+		_mm_store_ps(emitter.pColorA + i, _mm_add_ps(startA, _mm_mul_ps(deltaA, t)));
+		_mm_store_ps(emitter.pSize + i, _mm_add_ps(startSize, _mm_mul_ps(deltaSize, t)));
+
+		__m128 live = _mm_cmplt_ps(_mm_add_ps(laneIndices, _mm_set1_ps((f32)i)), liveCount);
+		minX = _mm_min_ps(minX, _mm_or_ps(_mm_and_ps(live, px), _mm_andnot_ps(live, minX)));
+		minY = _mm_min_ps(minY, _mm_or_ps(_mm_and_ps(live, py), _mm_andnot_ps(live, minY)));
+		minZ = _mm_min_ps(minZ, _mm_or_ps(_mm_and_ps(live, pz), _mm_andnot_ps(live, minZ)));
+		maxX = _mm_max_ps(maxX, _mm_or_ps(_mm_and_ps(live, px), _mm_andnot_ps(live, maxX)));
+		maxY = _mm_max_ps(maxY, _mm_or_ps(_mm_and_ps(live, py), _mm_andnot_ps(live, maxY)));
+		maxZ = _mm_max_ps(maxZ, _mm_or_ps(_mm_and_ps(live, pz), _mm_andnot_ps(live, maxZ)));
+	}
+
+	f32 lanes[6][PARTICLE_LANES];
+	_mm_storeu_ps(lanes[0], minX);
+	_mm_storeu_ps(lanes[1], minY);
+	_mm_storeu_ps(lanes[2], minZ);
+	_mm_storeu_ps(lanes[3], maxX);
+	_mm_storeu_ps(lanes[4], maxY);
+	_mm_storeu_ps(lanes[5], maxZ);
+	emitter.boundsMin = Vec3f(lanes[0][0], lanes[1][0], lanes[2][0]);
+	emitter.boundsMax = Vec3f(lanes[3][0], lanes[4][0], lanes[5][0]);
+	for (i32 lane = 1; lane < PARTICLE_LANES; lane++) {
+		emitter.boundsMin = Vec3f(min(emitter.boundsMin.x, lanes[0][lane]), min(emitter.boundsMin.y, lanes[1][lane]), min(emitter.boundsMin.z, lanes[2][lane]));
+		emitter.boundsMax = Vec3f(max(emitter.boundsMax.x, lanes[3][lane]), max(emitter.boundsMax.y, lanes[4][lane]), max(emitter.boundsMax.z, lanes[5][lane]));
+	}
+}
+
+// ***********************************************************************
+
+void RemoveDead(ParticleEmitter& emitter) {
+	f32* pArrays[PARTICLE_ARRAY_COUNT] = {
+		emitter.pPosX, emitter.pPosY, emitter.pPosZ,
+		emitter.pVelX, emitter.pVelY, emitter.pVelZ,
+		emitter.pAge, emitter.pInvLife,
+		emitter.pColorR, emitter.pColorG, emitter.pColorB, emitter.pColorA,
+		emitter.pSize
+	};
+
+	// order doesn't matter, swap with the last one
+	i32 i = 0;
+	while (i < emitter.count) {
+		if (emitter.pAge[i] * emitter.pInvLife[i] < 1.0f) {
+			i++;
+			continue;
+		}
+		i32 last = --emitter.count;
+		for (i32 a = 0; a < PARTICLE_ARRAY_COUNT; a++) {
+			pArrays[a][i] = pArrays[a][last];
+		}
+	}
+}
+
+// ***********************************************************************
+
+void Update(ParticleEmitter& emitter, f32 deltaTime) {
+	if (deltaTime <= 0.0f)
+		return;
+
+	if (emitter.count > 0) {
+		Integrate(emitter, deltaTime);
+		RemoveDead(emitter);
+	}
+
+	emitter.spawnDebt += emitter.rate * deltaTime;
+	i32 spawnCount = (i32)emitter.spawnDebt;
+	emitter.spawnDebt -= (f32)spawnCount;
+	Emit(emitter, spawnCount);
+}
+
+// ***********************************************************************
+
+Vec4f BuildBillboards(ParticleEmitter& emitter, Vec3f right, Vec3f up, PackedVertexData* pOutVertices) {
+	// the largest a particle can be is whichever end of its size range is bigger
+	f32 halfSize = max(fabsf(emitter.startSize), fabsf(emitter.endSize)) * 0.5f;
+	f32 reach = halfSize * (fabsf(right.x) + fabsf(right.y) + fabsf(right.z) + fabsf(up.x) + fabsf(up.y) + fabsf(up.z));
+	Vec3f extent;
+	extent.x = max(max(fabsf(emitter.boundsMin.x), fabsf(emitter.boundsMax.x)) + reach, 0.000001f);
+	extent.y = max(max(fabsf(emitter.boundsMin.y), fabsf(emitter.boundsMax.y)) + reach, 0.000001f);
+	extent.z = max(max(fabsf(emitter.boundsMin.z), fabsf(emitter.boundsMax.z)) + reach, 0.000001f);
+
+	__m128 scaleX = _mm_set1_ps(32767.0f / extent.x);
+	__m128 scaleY = _mm_set1_ps(32767.0f / extent.y);
+	__m128 scaleZ = _mm_set1_ps(32767.0f / extent.z);
+	__m128 half = _mm_set1_ps(0.5f);
+	__m128 colorScale = _mm_set1_ps(255.0f);
+	__m128 zero = _mm_setzero_ps();
+
+	// corner offsets in units of size, in the same order DrawSpriteRect emits its quad
+	static const f32 cornerRight[6] = { -1.0f, 1.0f, 1.0f, 1.0f, -1.0f, -1.0f };
+	static const f32 cornerUp[6] = { -1.0f, -1.0f, 1.0f, 1.0f, -1.0f, 1.0f };
+	static const i16 cornerU[6] = { 0, 32767, 32767, 32767, 0, 0 };
+	static const i16 cornerV[6] = { 32767, 32767, 0, 0, 32767, 0 };
+
+	for (i32 i = 0; i < emitter.count; i += PARTICLE_LANES) {
+		__m128 halfSizes = _mm_mul_ps(_mm_load_ps(emitter.pSize + i), half);
+		__m128 px = _mm_load_ps(emitter.pPosX + i);
+		__m128 py = _mm_load_ps(emitter.pPosY + i);
+		__m128 pz = _mm_load_ps(emitter.pPosZ + i);
+
+		// colours to rgba8, clamped to [0, 255] by the saturating packs
+		__m128i r = _mm_cvtps_epi32(_mm_mul_ps(_mm_max_ps(_mm_load_ps(emitter.pColorR + i), zero), colorScale));
+		__m128i g = _mm_cvtps_epi32(_mm_mul_ps(_mm_max_ps(_mm_load_ps(emitter.pColorG + i), zero), colorScale));
+		__m128i b = _mm_cvtps_epi32(_mm_mul_ps(_mm_max_ps(_mm_load_ps(emitter.pColorB + i), zero), colorScale));
+		__m128i a = _mm_cvtps_epi32(_mm_mul_ps(_mm_max_ps(_mm_load_ps(emitter.pColorA + i), zero), colorScale));
+		__m128i rg = _mm_packs_epi32(r, g);
+		__m128i ba = _mm_packs_epi32(b, a);
+		u8 channels[16];
+		_mm_storeu_si128((__m128i*)channels, _mm_packus_epi16(rg, ba));
+
+		i32 corners[6][3][PARTICLE_LANES];
+		for (i32 c = 0; c < 6; c++) {
+			__m128 offsetRight = _mm_mul_ps(halfSizes, _mm_set1_ps(cornerRight[c]));
+			__m128 offsetUp = _mm_mul_ps(halfSizes, _mm_set1_ps(cornerUp[c]));
+			__m128 cx = _mm_add_ps(px, _mm_add_ps(_mm_mul_ps(offsetRight, _mm_set1_ps(right.x)), _mm_mul_ps(offsetUp, _mm_set1_ps(up.x))));
+			__m128 cy = _mm_add_ps(py, _mm_add_ps(_mm_mul_ps(offsetRight, _mm_set1_ps(right.y)), _mm_mul_ps(offsetUp, _mm_set1_ps(up.y))));
+			__m128 cz = _mm_add_ps(pz, _mm_add_ps(_mm_mul_ps(offsetRight, _mm_set1_ps(right.z)), _mm_mul_ps(offsetUp, _mm_set1_ps(up.z))));
+			_mm_storeu_si128((__m128i*)corners[c][0], _mm_cvtps_epi32(_mm_mul_ps(cx, scaleX)));
+			_mm_storeu_si128((__m128i*)corners[c][1], _mm_cvtps_epi32(_mm_mul_ps(cy, scaleY)));
+			_mm_storeu_si128((__m128i*)corners[c][2], _mm_cvtps_epi32(_mm_mul_ps(cz, scaleZ)));
+		}
+
+		i32 lanes = min(PARTICLE_LANES, emitter.count - i);
+		for (i32 lane = 0; lane < lanes; lane++) {
+			PackedVertexData* pQuad = pOutVertices + (i64)(i + lane) * 6;
+			for (i32 c = 0; c < 6; c++) {
+				PackedVertexData& vert = pQuad[c];
+				vert.pos[0] = (i16)corners[c][0][lane];
+				vert.pos[1] = (i16)corners[c][1][lane];
+				vert.pos[2] = (i16)corners[c][2][lane];
+				vert.pos[3] = 32767;
+				vert.col[0] = channels[lane];
+				vert.col[1] = channels[4 + lane];
+				vert.col[2] = channels[8 + lane];
+				vert.col[3] = channels[12 + lane];
+				vert.tex[0] = cornerU[c];
+				vert.tex[1] = cornerV[c];
+				vert.norm[0] = 0;
+				vert.norm[1] = 0;
+				vert.norm[2] = 0;
+				vert.norm[3] = 0;
+			}
+		}
+	}
+	return Vec4f(extent.x, extent.y, extent.z, 1.0f);
+}
+
+}
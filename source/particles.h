@@ -0,0 +1,63 @@
+// Copyright 2020-2022 David Colson. All rights reserved.
+
+#pragma once
+
+// particles are simulated four at a time, so capacities are rounded up to this
+#define PARTICLE_LANES 4
+#define MAX_PARTICLES_PER_EMITTER 65536
+
+// An emitter and its particles, stored as a structure of arrays in one block of memory.
+// Live particles are packed at the front of the arrays, dead ones are swapped out
+struct ParticleEmitter {
+	i32 capacity;
+	i32 count;
+	bool is3D;
+
+	// emission settings
+	Vec3f position;
+	Vec3f positionSpread;
+	Vec3f velocityMin;
+	Vec3f velocityMax;
+	Vec3f gravity;
+	f32 drag;
+	f32 lifeMin;
+	f32 lifeMax;
+	f32 rate; // particles per second, spawned by Update
+	Vec4f startColor;
+	Vec4f endColor;
+	f32 startSize;
+	f32 endSize;
+
+	f32 spawnDebt;
+	u32 randomState;
+
+	// extents of the live particles after the last update, billboards are packed relative to these
+	Vec3f boundsMin;
+	Vec3f boundsMax;
+
+	f32* pPosX;
+	f32* pPosY;
+	f32* pPosZ;
+	f32* pVelX;
+	f32* pVelY;
+	f32* pVelZ;
+	f32* pAge;
+	f32* pInvLife;
+	f32* pColorR;
+	f32* pColorG;
+	f32* pColorB;
+	f32* pColorA;
+	f32* pSize;
+};
+
+namespace Particles {
+
+i64 GetEmitterSize(i32 capacity);
+void InitEmitter(ParticleEmitter* pEmitter, i32 capacity, bool is3D);
+void Emit(ParticleEmitter& emitter, i32 count);
+void Update(ParticleEmitter& emitter, f32 deltaTime);
+
+// Camera facing quads for every live particle, returns the unpack scale the positions were packed with
+Vec4f BuildBillboards(ParticleEmitter& emitter, Vec3f right, Vec3f up, PackedVertexData* pOutVertices);
+
+}
@@ -1,5 +1,8 @@
 // Copyright David Colson. All rights reserved.
 
+// userdata allocated since the last tick, and over the whole of the tick before that
+static i32 userDataAllocations = 0;
+static i32 lastFrameUserDataAllocations = 0;
 
 // ***********************************************************************
 
@@ -90,7 +93,19 @@ i32 GetImpl(lua_State* L, UserData* pUserData, i32 index, i32 count) {
 
 // ***********************************************************************
 
+void UserDataDestructor(void* pData) {
+	UserData* pUserData = (UserData*)pData;
+	if (pUserData->img.id != SG_INVALID_ID) {
+		GpuResources::RetireImage(pUserData->img);
+		pUserData->img.id = SG_INVALID_ID;
+	}
+}
+
+// ***********************************************************************
+
 UserData* AllocUserData(lua_State* L, Type type, i32 width, i32 height) {
+	userDataAllocations++;
+
 	i32 typeSize = 0;
 	switch (type) {
 		case Type::Float32: typeSize = sizeof(f32); break;
@@ -100,7 +115,7 @@ UserData* AllocUserData(lua_State* L, Type type, i32 width, i32 height) {
 	}
 
 	i32 bufSize = width * height * typeSize;
-	UserData* pUserData = (UserData*)lua_newuserdata(L, sizeof(UserData) + bufSize);
+	UserData* pUserData = (UserData*)lua_newuserdatadtor(L, sizeof(UserData) + bufSize, UserDataDestructor);
 	memset(pUserData, 0, sizeof(UserData) + bufSize);
 	pUserData->pData = (u8*)pUserData + sizeof(UserData);
 	pUserData->width = width;
@@ -117,6 +132,31 @@ UserData* AllocUserData(lua_State* L, Type type, i32 width, i32 height) {
 
 // ***********************************************************************
 
+UserData* AllocUserDataView(lua_State* L, Type type, i32 width, i32 height, u8* pData) {
+	// points at memory owned elsewhere, which must outlive the userdata
+	userDataAllocations++;
+	UserData* pUserData = (UserData*)lua_newuserdatadtor(L, sizeof(UserData), UserDataDestructor);
+	memset(pUserData, 0, sizeof(UserData));
+	pUserData->pData = pData;
+	pUserData->width = width;
+	pUserData->height = height;
+	pUserData->type = type;
+	pUserData->img.id = SG_INVALID_ID;
+ 
+	luaL_getmetatable(L, "UserData");
+	lua_setmetatable(L, -2);
+	return pUserData;
+}
+
+// ***********************************************************************
+
+void UserDataNewFrame() {
+	lastFrameUserDataAllocations = userDataAllocations;
+	userDataAllocations = 0;
+}
+
+// ***********************************************************************
+
 i64 GetUserDataSize(UserData* pUserData) {
 	i32 typeSize = 0;
 	switch (pUserData->type) {
@@ -144,11 +184,15 @@ void UpdateUserDataImage(UserData* pUserData) {
 			.pixel_format = SG_PIXELFORMAT_RGBA8,
 		};
 
+		// the render thread may be mid frame
+		LockGpu();
+		defer(UnlockGpu());
+
 		// make dynamic if someone is editing this
 		// image after creation
 		pUserData->dynamic = false;
 		if (pUserData->img.id != SG_INVALID_ID) {
-			sg_destroy_image(pUserData->img);
+			GpuResources::RetireImage(pUserData->img);
 			imageDesc.usage = SG_USAGE_STREAM;
 			pUserData->dynamic = true;
 		}
@@ -158,20 +202,20 @@ void UpdateUserDataImage(UserData* pUserData) {
 		pixelsData.size = pUserData->width * pUserData->height * 4 * sizeof(u8);
 		imageDesc.data.subimage[0][0] = pixelsData;
 		pUserData->img = sg_make_image(&imageDesc);
+		GpuResources::TrackImage(pUserData->img, (i64)pixelsData.size, pUserData);
 		pUserData->dirty = false;
+		RecordTextureUpload(pUserData->img, (i64)pixelsData.size);
 	}
 
-	// @todo: only allow one edit per frame, somehow block this
 	if (pUserData->dirty && pUserData->dynamic) {
-		// already dynamic, so we can just update it
-		sg_range range;
-		range.ptr = (void*)pUserData->pData;
-		range.size = pUserData->width * pUserData->height * 4 * sizeof(u8);
-		sg_image_data data;
-		data.subimage[0][0] = range;
-		sg_update_image(pUserData->img, data);  
+		// already dynamic, so we can just update it, the render thread uploads it with this frame
+		i64 size = pUserData->width * pUserData->height * 4 * sizeof(u8);
+		QueueImageUpdate(pUserData->img, pUserData->pData, size);
+		RecordTextureUpload(pUserData->img, size);
 	}
 
+	GpuResources::TouchImage(pUserData->img);
+
 }
 
 // ***********************************************************************
@@ -515,61 +559,146 @@ i32 Size(lua_State* L) {
 
 // ***********************************************************************
 
-#define OPERATOR_FUNC(op, name) 											\
-i32 name(lua_State* L) {													\
-    UserData* pUserData1 = (UserData*)luaL_checkudata(L, 1, "UserData");			\
-    UserData* pUserData2 = (UserData*)luaL_checkudata(L, 2, "UserData");			\
-																			\
-	if (pUserData1->type != pUserData2->type) {									\
-		luaL_error(L, "Type mismatch in userdata operation");					\
-	}																		\
-	i32 buf1Size = pUserData1->width * pUserData1->height;						\
-	i32 buf2Size = pUserData2->width * pUserData2->height;						\
-	i32 resultSize = min(buf1Size, buf2Size);								\
-																			\
-	UserData* pUserData = AllocUserData(L, pUserData1->type, pUserData1->width, pUserData1->height);\
-																			\
-	switch(pUserData->type) {													\
-		case Type::Float32: {												\
-			f32* pResult = (f32*)pUserData->pData;							\
-			f32* pBuf1 = (f32*)pUserData1->pData;								\
-			f32* pBuf2 = (f32*)pUserData2->pData;								\
-			for (int i=0; i < resultSize; i++) 								\
-				pResult[i] = pBuf1[i] op pBuf2[i];							\
-			break;															\
-		}																	\
-		case Type::Int32: {													\
-			i32* pResult = (i32*)pUserData->pData;							\
-			i32* pBuf1 = (i32*)pUserData1->pData;								\
-			i32* pBuf2 = (i32*)pUserData2->pData;								\
-			for (int i=0; i < resultSize; i++)								\
-				pResult[i] = pBuf1[i] op pBuf2[i];							\
-			break;															\
-		}																	\
-		case Type::Int16: {													\
-			i16* pResult = (i16*)pUserData->pData;							\
-			i16* pBuf1 = (i16*)pUserData1->pData;								\
-			i16* pBuf2 = (i16*)pUserData2->pData;								\
-			for (int i=0; i < resultSize; i++) 								\
-				pResult[i] = pBuf1[i] op pBuf2[i];							\
-			break;															\
-		}																	\
-		case Type::Uint8: {													\
-			u8* pResult = (u8*)pUserData->pData;								\
-			u8* pBuf1 = (u8*)pUserData1->pData;								\
-			u8* pBuf2 = (u8*)pUserData2->pData;								\
-			for (int i=0; i < resultSize; i++) 								\
-				pResult[i] = pBuf1[i] op pBuf2[i];							\
-			break;															\
-		}																	\
-	}																		\
-	return 1;																\
-}																			
-
-OPERATOR_FUNC(+, Add)
-OPERATOR_FUNC(-, Sub)
-OPERATOR_FUNC(*, Mul)
-OPERATOR_FUNC(/, Div)
+i32 ApplyOperator(lua_State* L, UserDataKernels::Op op) {
+    UserData* pUserData1 = (UserData*)luaL_checkudata(L, 1, "UserData");
+    UserData* pUserData2 = (UserData*)luaL_checkudata(L, 2, "UserData");
+
+	if (pUserData1->type != pUserData2->type) {
+		luaL_error(L, "Type mismatch in userdata operation");
+	}
+	i32 buf1Size = pUserData1->width * pUserData1->height;
+	i32 buf2Size = pUserData2->width * pUserData2->height;
+	i32 resultSize = min(buf1Size, buf2Size);
+
+	UserData* pUserData = AllocUserData(L, pUserData1->type, pUserData1->width, pUserData1->height);
+	UserDataKernels::Run(op, pUserData->type, pUserData->pData, pUserData1->pData, pUserData2->pData, resultSize);
+	return 1;
+}
+
+// ***********************************************************************
+
+#define OPERATOR_FUNC(op) 													\
+i32 op(lua_State* L) {														\
+	return ApplyOperator(L, UserDataKernels::Op::op);						\
+}
+
+OPERATOR_FUNC(Add)
+OPERATOR_FUNC(Sub)
+OPERATOR_FUNC(Mul)
+OPERATOR_FUNC(Div)
+
+// ***********************************************************************
+
+// a:add(b) works in place on a, a:add(b, out) writes to out instead, neither allocates
+i32 ApplyOperatorInto(lua_State* L, UserDataKernels::Op op) {
+    UserData* pUserData1 = (UserData*)luaL_checkudata(L, 1, "UserData");
+    UserData* pUserData2 = (UserData*)luaL_checkudata(L, 2, "UserData");
+	i32 resultIndex = lua_isnoneornil(L, 3) ? 1 : 3;
+	UserData* pResult = (UserData*)luaL_checkudata(L, resultIndex, "UserData");
+
+	if (pUserData1->type != pUserData2->type || pUserData1->type != pResult->type) {
+		luaL_error(L, "Type mismatch in userdata operation");
+	}
+	if (!UserDataKernels::IsSupported(op, pUserData1->type)) {
+		luaL_error(L, "Saturating operations only work on i16 and u8 userdata");
+	}
+	i32 buf1Size = pUserData1->width * pUserData1->height;
+	i32 buf2Size = pUserData2->width * pUserData2->height;
+	i32 resultSize = min(min(buf1Size, buf2Size), pResult->width * pResult->height);
+
+	UserDataKernels::Run(op, pResult->type, pResult->pData, pUserData1->pData, pUserData2->pData, resultSize);
+	lua_pushvalue(L, resultIndex);
+	return 1;
+}
+
+// ***********************************************************************
+
+// Converts a number to the element type of the userdata, numbers that don't fit are an error rather than wrapping.
+// Returns whether the converted value is zero
+bool ConvertScalar(lua_State* L, Type type, f64 scalar, void* pOut) {
+	switch (type) {
+		case Type::Float32: {
+			if (fabs(scalar) > 3.4028234663852886e38 && !isinf(scalar))
+				luaL_error(L, "Scalar %f is out of range for f32 userdata", scalar);
+			f32 value = (f32)scalar;
+			memcpy(pOut, &value, sizeof(value));
+			return value == 0.0f;
+		}
+		case Type::Int32: {
+			if (!(scalar > -2147483649.0 && scalar < 2147483648.0))
+				luaL_error(L, "Scalar %f is out of range for i32 userdata", scalar);
+			i32 value = (i32)scalar;
+			memcpy(pOut, &value, sizeof(value));
+			return value == 0;
+		}
+		case Type::Int16: {
+			if (!(scalar > -32769.0 && scalar < 32768.0))
+				luaL_error(L, "Scalar %f is out of range for i16 userdata", scalar);
+			i16 value = (i16)scalar;
+			memcpy(pOut, &value, sizeof(value));
+			return value == 0;
+		}
+		case Type::Uint8: {
+			if (!(scalar > -1.0 && scalar < 256.0))
+				luaL_error(L, "Scalar %f is out of range for u8 userdata", scalar);
+			u8 value = (u8)scalar;
+			memcpy(pOut, &value, sizeof(value));
+			return value == 0;
+		}
+	}
+	return false;
+}
+
+// ***********************************************************************
+
+// same again against a single number, a:mul_scalar(2) or a:mul_scalar(2, out)
+i32 ApplyScalarOperatorInto(lua_State* L, UserDataKernels::Op op) {
+    UserData* pUserData = (UserData*)luaL_checkudata(L, 1, "UserData");
+	f64 scalar = luaL_checknumber(L, 2);
+	i32 resultIndex = lua_isnoneornil(L, 3) ? 1 : 3;
+	UserData* pResult = (UserData*)luaL_checkudata(L, resultIndex, "UserData");
+
+	if (pUserData->type != pResult->type) {
+		luaL_error(L, "Type mismatch in userdata operation");
+	}
+	if (!UserDataKernels::IsSupported(op, pUserData->type)) {
+		luaL_error(L, "Saturating operations only work on i16 and u8 userdata");
+	}
+	u8 element[sizeof(f32)];
+	bool isZero = ConvertScalar(L, pUserData->type, scalar, element);
+	if (op == UserDataKernels::Op::Div && pUserData->type != Type::Float32 && isZero) {
+		luaL_error(L, "Integer userdata divided by zero");
+	}
+	i32 resultSize = min(pUserData->width * pUserData->height, pResult->width * pResult->height);
+
+	UserDataKernels::RunScalar(op, pResult->type, pResult->pData, pUserData->pData, element, resultSize);
+	lua_pushvalue(L, resultIndex);
+	return 1;
+}
+
+// ***********************************************************************
+
+#define OPERATOR_INTO_FUNC(op) 												\
+i32 op##Into(lua_State* L) {												\
+	return ApplyOperatorInto(L, UserDataKernels::Op::op);					\
+}																			\
+i32 op##ScalarInto(lua_State* L) {											\
+	return ApplyScalarOperatorInto(L, UserDataKernels::Op::op);				\
+}
+
+OPERATOR_INTO_FUNC(Add)
+OPERATOR_INTO_FUNC(Sub)
+OPERATOR_INTO_FUNC(Mul)
+OPERATOR_INTO_FUNC(Div)
+OPERATOR_INTO_FUNC(AddSaturate)
+OPERATOR_INTO_FUNC(SubSaturate)
+
+// ***********************************************************************
+
+i32 UserDataAllocations(lua_State* L) {
+	lua_pushinteger(L, lastFrameUserDataAllocations);
+	return 1;
+}
 
 // ***********************************************************************
 
@@ -676,12 +805,14 @@ i32 VecDot(lua_State* L) {
 // ***********************************************************************
 
 void BindUserData(lua_State* L) {
+	UserDataKernels::Init();
 
 	// register global functions
     const luaL_Reg globalFuncs[] = {
         { "userdata", NewUserData },
         { "vec", NewVec },
         { "quat", NewQuat },
+        { "userdata_allocations", UserDataAllocations },
         { NULL, NULL }
     };
 
@@ -701,6 +832,18 @@ void BindUserData(lua_State* L) {
         { "__sub", Sub },
         { "__mul", Mul },
         { "__div", Div },
+        { "add", AddInto },
+        { "sub", SubInto },
+        { "mul", MulInto },
+        { "div", DivInto },
+        { "add_sat", AddSaturateInto },
+        { "sub_sat", SubSaturateInto },
+        { "add_scalar", AddScalarInto },
+        { "sub_scalar", SubScalarInto },
+        { "mul_scalar", MulScalarInto },
+        { "div_scalar", DivScalarInto },
+        { "add_sat_scalar", AddSaturateScalarInto },
+        { "sub_sat_scalar", SubSaturateScalarInto },
         { "set", Set },
         { "set2D", Set2D },
         { "get", Get },
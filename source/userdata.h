@@ -24,7 +24,11 @@ struct UserData {
 };
 
 UserData* AllocUserData(lua_State* L, Type type, i32 width, i32 height);
+UserData* AllocUserDataView(lua_State* L, Type type, i32 width, i32 height, u8* pData);
 i64 GetUserDataSize(UserData* pUserData);
+
+// Rolls the allocation counter over, called once per tick
+void UserDataNewFrame();
 void UpdateUserDataImage(UserData* pUserData);
 void ParseUserDataString(lua_State* L, String dataString, UserData* pUserData);
 void BindUserData(lua_State* L);
@@ -0,0 +1,129 @@
+// Copyright David Colson. All rights reserved.
+
+// Standalone benchmark for the userdata math kernels, built with "build.bat bench".
+// Times every type and operation against a plain scalar loop, from vec3 sized buffers up to a million elements
+
+#define _CRT_SECURE_NO_WARNINGS
+
+// platform
+#include "Windows.h"
+#include "dbghelp.h"
+#undef min
+#undef max
+#pragma comment(lib, "kernel32")
+#pragma comment(lib, "psapi")
+#pragma comment(lib, "dbghelp")
+
+// stdlib
+#include <math.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <stdarg.h>
+#include <stdint.h>
+#include <xmmintrin.h>
+#include <emmintrin.h>
+#include <immintrin.h>
+#include <intrin.h>
+
+// common_lib
+#include "common_lib.h"
+#include "common_lib.cpp"
+
+#include <sokol_gfx.h>
+
+#include "userdata.h"
+#include "userdata_kernels.h"
+#include "userdata_kernels.cpp"
+
+// roughly how many elements each measurement pushes through, so small buffers run many times
+#define BENCH_ELEMENTS_PER_RUN (64 * 1024 * 1024)
+
+// ***********************************************************************
+
+template<typename T>
+void ScalarLoop(UserDataKernels::Op op, T* pResult, T* pA, T* pB, i64 count) {
+	switch (op) {
+		case UserDataKernels::Op::Add: for (i64 i = 0; i < count; i++) pResult[i] = pA[i] + pB[i]; break;
+		case UserDataKernels::Op::Sub: for (i64 i = 0; i < count; i++) pResult[i] = pA[i] - pB[i]; break;
+		case UserDataKernels::Op::Mul: for (i64 i = 0; i < count; i++) pResult[i] = pA[i] * pB[i]; break;
+		case UserDataKernels::Op::Div: for (i64 i = 0; i < count; i++) pResult[i] = pA[i] / pB[i]; break;
+		default: break;
+	}
+}
+
+// ***********************************************************************
+
+f64 Seconds(LARGE_INTEGER start, LARGE_INTEGER end, LARGE_INTEGER frequency) {
+	return (f64)(end.QuadPart - start.QuadPart) / (f64)frequency.QuadPart;
+}
+
+// ***********************************************************************
+
+template<typename T>
+void BenchType(Type type, const char* typeName) {
+	const char* opNames[] = { "add", "sub", "mul", "div", "add_sat", "sub_sat" };
+	i64 sizes[] = { 3, 16, 256, 4096, 65536, 1024 * 1024 };
+	i64 maxCount = sizes[sizeof(sizes) / sizeof(sizes[0]) - 1];
+
+	T* pA = (T*)malloc(maxCount * sizeof(T));
+	T* pB = (T*)malloc(maxCount * sizeof(T));
+	T* pResult = (T*)malloc(maxCount * sizeof(T));
+	for (i64 i = 0; i < maxCount; i++) {
+		pA[i] = (T)(i % 100 + 1);
+		pB[i] = (T)(i % 7 + 1);
+	}
+
+	LARGE_INTEGER frequency;
+	QueryPerformanceFrequency(&frequency);
+
+	for (i32 op = 0; op < (i32)UserDataKernels::Op::Count; op++) {
+		if (!UserDataKernels::IsSupported((UserDataKernels::Op)op, type))
+			continue;
+
+		for (i32 s = 0; s < sizeof(sizes) / sizeof(sizes[0]); s++) {
+			i64 count = sizes[s];
+			i64 runs = max(BENCH_ELEMENTS_PER_RUN / count, (i64)1);
+			LARGE_INTEGER start, end;
+
+			QueryPerformanceCounter(&start);
+			for (i64 r = 0; r < runs; r++)
+				UserDataKernels::Run((UserDataKernels::Op)op, type, (u8*)pResult, (u8*)pA, (u8*)pB, count);
+			QueryPerformanceCounter(&end);
+			f64 kernelTime = Seconds(start, end, frequency);
+
+			// saturating ops have no plain C++ equivalent to compare with
+			f64 scalarTime = 0.0;
+			if (op <= (i32)UserDataKernels::Op::Div) {
+				QueryPerformanceCounter(&start);
+				for (i64 r = 0; r < runs; r++)
+					ScalarLoop((UserDataKernels::Op)op, pResult, pA, pB, count);
+				QueryPerformanceCounter(&end);
+				scalarTime = Seconds(start, end, frequency);
+			}
+
+			// two reads and a write per element
+			f64 bytes = 3.0 * sizeof(T) * (f64)count * (f64)runs;
+			f64 elements = (f64)count * (f64)runs;
+			printf("%-4s %-8s %8lld  kernel %7.3f ns/elem %7.2f GB/s", typeName, opNames[op], count, kernelTime * 1e9 / elements, bytes / kernelTime / 1e9);
+			if (scalarTime > 0.0)
+				printf("  scalar %7.3f ns/elem  x%.2f", scalarTime * 1e9 / elements, scalarTime / kernelTime);
+			printf("\n");
+		}
+	}
+
+	free(pA);
+	free(pB);
+	free(pResult);
+}
+
+// ***********************************************************************
+
+int main(int argc, char* argv[]) {
+	UserDataKernels::Init();
+	BenchType<f32>(Type::Float32, "f32");
+	BenchType<i32>(Type::Int32, "i32");
+	BenchType<i16>(Type::Int16, "i16");
+	BenchType<u8>(Type::Uint8, "u8");
+	return 0;
+}
@@ -0,0 +1,253 @@
+// Copyright David Colson. All rights reserved.
+
+// Element wise userdata math. Every type and operation gets its own SSE2 kernel, which any
+// x64 cpu has, and AVX2 versions of the same replace them at startup when the cpu supports it.
+// Integer results wrap the same way the plain C++ loops used to, except the saturating ops.
+
+namespace UserDataKernels {
+
+#define USERDATA_TYPE_COUNT 4
+#define SCALAR_BLOCK_BYTES 1024
+
+typedef void (*Kernel)(u8* pResult, u8* pA, u8* pB, i64 count);
+
+static Kernel kernels[(i32)Op::Count][USERDATA_TYPE_COUNT];
+static bool initialized = false;
+
+// ***********************************************************************
+
+inline __m128 LoadF32x4(void* p) { return _mm_loadu_ps((f32*)p); }
+inline void StoreF32x4(void* p, __m128 v) { _mm_storeu_ps((f32*)p, v); }
+inline __m128i Load128(void* p) { return _mm_loadu_si128((__m128i*)p); }
+inline void Store128(void* p, __m128i v) { _mm_storeu_si128((__m128i*)p, v); }
+
+inline __m256 LoadF32x8(void* p) { return _mm256_loadu_ps((f32*)p); }
+inline void StoreF32x8(void* p, __m256 v) { _mm256_storeu_ps((f32*)p, v); }
+inline __m256i Load256(void* p) { return _mm256_loadu_si256((__m256i*)p); }
+inline void Store256(void* p, __m256i v) { _mm256_storeu_si256((__m256i*)p, v); }
+
+inline i16 SaturateI16(i32 value) { return (i16)clamp(value, -32768, 32767); }
+inline u8 SaturateU8(i32 value) { return (u8)clamp(value, 0, 255); }
+
+// ***********************************************************************
+
+// SSE2 has no 32 bit multiply, so multiply the even and odd lanes to 64 bits and keep the low halves
+inline __m128i MulLo32Sse2(__m128i a, __m128i b) {
+	__m128i even = _mm_mul_epu32(a, b);
+	__m128i odd = _mm_mul_epu32(_mm_srli_epi64(a, 32), _mm_srli_epi64(b, 32));
+	return _mm_unpacklo_epi32(_mm_shuffle_epi32(even, _MM_SHUFFLE(0, 0, 2, 0)), _mm_shuffle_epi32(odd, _MM_SHUFFLE(0, 0, 2, 0)));
+}
+
+// ***********************************************************************
+
+// nor is there an 8 bit one, so multiply as 16 bit lanes, even bytes in place and odd bytes shifted down
+inline __m128i MulLo8Sse2(__m128i a, __m128i b) {
+	__m128i even = _mm_mullo_epi16(a, b);
+	__m128i odd = _mm_mullo_epi16(_mm_srli_epi16(a, 8), _mm_srli_epi16(b, 8));
+	return _mm_or_si128(_mm_and_si128(even, _mm_set1_epi16(0xff)), _mm_slli_epi16(odd, 8));
+}
+
+// ***********************************************************************
+
+inline __m256i MulLo8Avx2(__m256i a, __m256i b) {
+	__m256i even = _mm256_mullo_epi16(a, b);
+	__m256i odd = _mm256_mullo_epi16(_mm256_srli_epi16(a, 8), _mm256_srli_epi16(b, 8));
+	return _mm256_or_si256(_mm256_and_si256(even, _mm256_set1_epi16(0xff)), _mm256_slli_epi16(odd, 8));
+}
+
+// ***********************************************************************
+
+// Full vectors first, then whatever is left one element at a time
+#define VECTOR_KERNEL(name, T, lanes, load, store, vectorOp, scalarOp, finish)	\
+void name(u8* pResult, u8* pA, u8* pB, i64 count) {							\
+	T* pR = (T*)pResult;														\
+	T* pX = (T*)pA;																\
+	T* pY = (T*)pB;																\
+	i64 i = 0;																	\
+	for (; i + lanes <= count; i += lanes)										\
+		store(pR + i, vectorOp(load(pX + i), load(pY + i)));					\
+	finish;																		\
+	for (; i < count; i++) {													\
+		T a = pX[i];															\
+		T b = pY[i];															\
+		pR[i] = (T)(scalarOp);													\
+	}																			\
+}
+
+#define SSE2_KERNEL(name, T, load, store, vectorOp, scalarOp) \
+	VECTOR_KERNEL(name, T, 16 / sizeof(T), load, store, vectorOp, scalarOp, (void)0)
+
+// avoids the penalty for mixing with SSE code after the kernel returns
+#define AVX2_KERNEL(name, T, load, store, vectorOp, scalarOp) \
+	VECTOR_KERNEL(name, T, 32 / sizeof(T), load, store, vectorOp, scalarOp, _mm256_zeroupper())
+
+SSE2_KERNEL(AddF32Sse2, f32, LoadF32x4, StoreF32x4, _mm_add_ps, a + b)
+SSE2_KERNEL(SubF32Sse2, f32, LoadF32x4, StoreF32x4, _mm_sub_ps, a - b)
+SSE2_KERNEL(MulF32Sse2, f32, LoadF32x4, StoreF32x4, _mm_mul_ps, a * b)
+SSE2_KERNEL(DivF32Sse2, f32, LoadF32x4, StoreF32x4, _mm_div_ps, a / b)
+SSE2_KERNEL(AddI32Sse2, i32, Load128, Store128, _mm_add_epi32, (u32)a + (u32)b)
+SSE2_KERNEL(SubI32Sse2, i32, Load128, Store128, _mm_sub_epi32, (u32)a - (u32)b)
+SSE2_KERNEL(MulI32Sse2, i32, Load128, Store128, MulLo32Sse2, (u32)a * (u32)b)
+SSE2_KERNEL(AddI16Sse2, i16, Load128, Store128, _mm_add_epi16, a + b)
+SSE2_KERNEL(SubI16Sse2, i16, Load128, Store128, _mm_sub_epi16, a - b)
+SSE2_KERNEL(MulI16Sse2, i16, Load128, Store128, _mm_mullo_epi16, a * b)
+SSE2_KERNEL(AddSaturateI16Sse2, i16, Load128, Store128, _mm_adds_epi16, SaturateI16(a + b))
+SSE2_KERNEL(SubSaturateI16Sse2, i16, Load128, Store128, _mm_subs_epi16, SaturateI16(a - b))
+SSE2_KERNEL(AddU8Sse2, u8, Load128, Store128, _mm_add_epi8, a + b)
+SSE2_KERNEL(SubU8Sse2, u8, Load128, Store128, _mm_sub_epi8, a - b)
+SSE2_KERNEL(MulU8Sse2, u8, Load128, Store128, MulLo8Sse2, a * b)
+SSE2_KERNEL(AddSaturateU8Sse2, u8, Load128, Store128, _mm_adds_epu8, SaturateU8(a + b))
+SSE2_KERNEL(SubSaturateU8Sse2, u8, Load128, Store128, _mm_subs_epu8, SaturateU8(a - b))
+
+AVX2_KERNEL(AddF32Avx2, f32, LoadF32x8, StoreF32x8, _mm256_add_ps, a + b)
+AVX2_KERNEL(SubF32Avx2, f32, LoadF32x8, StoreF32x8, _mm256_sub_ps, a - b)
+AVX2_KERNEL(MulF32Avx2, f32, LoadF32x8, StoreF32x8, _mm256_mul_ps, a * b)
+AVX2_KERNEL(DivF32Avx2, f32, LoadF32x8, StoreF32x8, _mm256_div_ps, a / b)
+AVX2_KERNEL(AddI32Avx2, i32, Load256, Store256, _mm256_add_epi32, (u32)a + (u32)b)
+AVX2_KERNEL(SubI32Avx2, i32, Load256, Store256, _mm256_sub_epi32, (u32)a - (u32)b)
+AVX2_KERNEL(MulI32Avx2, i32, Load256, Store256, _mm256_mullo_epi32, (u32)a * (u32)b)
+AVX2_KERNEL(AddI16Avx2, i16, Load256, Store256, _mm256_add_epi16, a + b)
+AVX2_KERNEL(SubI16Avx2, i16, Load256, Store256, _mm256_sub_epi16, a - b)
+AVX2_KERNEL(MulI16Avx2, i16, Load256, Store256, _mm256_mullo_epi16, a * b)
+AVX2_KERNEL(AddSaturateI16Avx2, i16, Load256, Store256, _mm256_adds_epi16, SaturateI16(a + b))
+AVX2_KERNEL(SubSaturateI16Avx2, i16, Load256, Store256, _mm256_subs_epi16, SaturateI16(a - b))
+AVX2_KERNEL(AddU8Avx2, u8, Load256, Store256, _mm256_add_epi8, a + b)
+AVX2_KERNEL(SubU8Avx2, u8, Load256, Store256, _mm256_sub_epi8, a - b)
+AVX2_KERNEL(MulU8Avx2, u8, Load256, Store256, MulLo8Avx2, a * b)
+AVX2_KERNEL(AddSaturateU8Avx2, u8, Load256, Store256, _mm256_adds_epu8, SaturateU8(a + b))
+AVX2_KERNEL(SubSaturateU8Avx2, u8, Load256, Store256, _mm256_subs_epu8, SaturateU8(a - b))
+
+// ***********************************************************************
+
+// no integer division instructions in either set, these stay scalar
+// x / 0 gives 0, and min / -1 wraps back to min, rather than trapping like the hardware would
+template<typename T>
+void DivScalar(u8* pResult, u8* pA, u8* pB, i64 count) {
+	T* pR = (T*)pResult;
+	T* pX = (T*)pA;
+	T* pY = (T*)pB;
+	for (i64 i = 0; i < count; i++) {
+		if (pY[i] == 0)
+			pR[i] = 0;
+		else if (T(-1) < T(0) && pY[i] == T(-1))
+			pR[i] = (T)(0ull - (u64)(i64)pX[i]); // negate in unsigned so it wraps
+		else
+			pR[i] = (T)(pX[i] / pY[i]);
+	}
+}
+
+// ***********************************************************************
+
+bool HasAvx2() {
+	i32 info[4];
+	__cpuid(info, 0);
+	if (info[0] < 7)
+		return false;
+
+	// the os also has to be saving the upper halves of the ymm registers
+	__cpuid(info, 1);
+	bool osxsave = (info[2] & (1 << 27)) != 0;
+	bool avx = (info[2] & (1 << 28)) != 0;
+	if (!osxsave || !avx || (_xgetbv(0) & 6) != 6)
+		return false;
+
+	__cpuidex(info, 7, 0);
+	return (info[1] & (1 << 5)) != 0;
+}
+
+// ***********************************************************************
+
+void SetKernel(Op op, Type type, Kernel kernel) {
+	kernels[(i32)op][(i32)type] = kernel;
+}
+
+// ***********************************************************************
+
+void Init() {
+	if (initialized)
+		return;
+
+	SetKernel(Op::Add, Type::Float32, AddF32Sse2);
+	SetKernel(Op::Sub, Type::Float32, SubF32Sse2);
+	SetKernel(Op::Mul, Type::Float32, MulF32Sse2);
+	SetKernel(Op::Div, Type::Float32, DivF32Sse2);
+	SetKernel(Op::Add, Type::Int32, AddI32Sse2);
+	SetKernel(Op::Sub, Type::Int32, SubI32Sse2);
+	SetKernel(Op::Mul, Type::Int32, MulI32Sse2);
+	SetKernel(Op::Div, Type::Int32, DivScalar<i32>);
+	SetKernel(Op::Add, Type::Int16, AddI16Sse2);
+	SetKernel(Op::Sub, Type::Int16, SubI16Sse2);
+	SetKernel(Op::Mul, Type::Int16, MulI16Sse2);
+	SetKernel(Op::Div, Type::Int16, DivScalar<i16>);
+	SetKernel(Op::AddSaturate, Type::Int16, AddSaturateI16Sse2);
+	SetKernel(Op::SubSaturate, Type::Int16, SubSaturateI16Sse2);
+	SetKernel(Op::Add, Type::Uint8, AddU8Sse2);
+	SetKernel(Op::Sub, Type::Uint8, SubU8Sse2);
+	SetKernel(Op::Mul, Type::Uint8, MulU8Sse2);
+	SetKernel(Op::Div, Type::Uint8, DivScalar<u8>);
+	SetKernel(Op::AddSaturate, Type::Uint8, AddSaturateU8Sse2);
+	SetKernel(Op::SubSaturate, Type::Uint8, SubSaturateU8Sse2);
+
+	if (HasAvx2()) {
+		SetKernel(Op::Add, Type::Float32, AddF32Avx2);
+		SetKernel(Op::Sub, Type::Float32, SubF32Avx2);
+		SetKernel(Op::Mul, Type::Float32, MulF32Avx2);
+		SetKernel(Op::Div, Type::Float32, DivF32Avx2);
+		SetKernel(Op::Add, Type::Int32, AddI32Avx2);
+		SetKernel(Op::Sub, Type::Int32, SubI32Avx2);
+		SetKernel(Op::Mul, Type::Int32, MulI32Avx2);
+		SetKernel(Op::Add, Type::Int16, AddI16Avx2);
+		SetKernel(Op::Sub, Type::Int16, SubI16Avx2);
+		SetKernel(Op::Mul, Type::Int16, MulI16Avx2);
+		SetKernel(Op::AddSaturate, Type::Int16, AddSaturateI16Avx2);
+		SetKernel(Op::SubSaturate, Type::Int16, SubSaturateI16Avx2);
+		SetKernel(Op::Add, Type::Uint8, AddU8Avx2);
+		SetKernel(Op::Sub, Type::Uint8, SubU8Avx2);
+		SetKernel(Op::Mul, Type::Uint8, MulU8Avx2);
+		SetKernel(Op::AddSaturate, Type::Uint8, AddSaturateU8Avx2);
+		SetKernel(Op::SubSaturate, Type::Uint8, SubSaturateU8Avx2);
+		Log::Info("Userdata math using AVX2 kernels");
+	}
+	initialized = true;
+}
+
+// ***********************************************************************
+
+bool IsSupported(Op op, Type type) {
+	return kernels[(i32)op][(i32)type] != nullptr;
+}
+
+// ***********************************************************************
+
+void Run(Op op, Type type, u8* pResult, u8* pA, u8* pB, i64 count) {
+	Kernel kernel = kernels[(i32)op][(i32)type];
+	if (kernel && count > 0)
+		kernel(pResult, pA, pB, count);
+}
+
+// ***********************************************************************
+
+void RunScalar(Op op, Type type, u8* pResult, u8* pA, const void* pScalar, i64 count) {
+	Kernel kernel = kernels[(i32)op][(i32)type];
+	if (kernel == nullptr || count <= 0)
+		return;
+
+	i32 typeSize = 0;
+	switch (type) {
+		case Type::Float32: typeSize = sizeof(f32); break;
+		case Type::Int32: typeSize = sizeof(i32); break;
+		case Type::Int16: typeSize = sizeof(i16); break;
+		case Type::Uint8: typeSize = sizeof(u8); break;
+	}
+
+	// the scalar is repeated through a small block, which the kernels then use as the second input
+	alignas(32) u8 block[SCALAR_BLOCK_BYTES];
+	for (i32 i = 0; i < SCALAR_BLOCK_BYTES; i += typeSize)
+		memcpy(block + i, pScalar, typeSize);
+
+	i64 blockCount = SCALAR_BLOCK_BYTES / typeSize;
+	for (i64 i = 0; i < count; i += blockCount)
+		kernel(pResult + i * typeSize, pA + i * typeSize, block, min(blockCount, count - i));
+}
+
+}
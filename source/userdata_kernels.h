@@ -0,0 +1,29 @@
+// Copyright David Colson. All rights reserved.
+#pragma once
+
+enum class Type:u8;
+
+namespace UserDataKernels {
+
+// element wise operations, the saturating ones are only defined for Int16 and Uint8
+enum class Op:u8 {
+	Add,
+	Sub,
+	Mul,
+	Div,
+	AddSaturate,
+	SubSaturate,
+	Count
+};
+
+// Picks the widest kernels the cpu supports, safe to call more than once
+void Init();
+bool IsSupported(Op op, Type type);
+
+// pResult may be the same as either input
+void Run(Op op, Type type, u8* pResult, u8* pA, u8* pB, i64 count);
+
+// Same again with every element of the second input being pScalar, which must already be of the element type
+void RunScalar(Op op, Type type, u8* pResult, u8* pA, const void* pScalar, i64 count);
+
+}
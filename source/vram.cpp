@@ -0,0 +1,113 @@
+// Copyright 2020-2022 David Colson. All rights reserved.
+
+// Scripts write texture pages and cluts straight into this surface, and draws reference them
+// by page and clut position, so the whole texture working set is one gpu texture. Writes mark
+// 64x64 tiles dirty, and only those tiles are copied out and uploaded at the end of the frame.
+
+#define VRAM_TILES_X (VRAM_WIDTH / VRAM_TILE_SIZE)
+#define VRAM_TILES_Y (VRAM_HEIGHT / VRAM_TILE_SIZE)
+
+namespace Vram {
+
+struct VramState {
+	u16* pPixels;
+	sg_image image;
+	bool dirtyTiles[VRAM_TILES_Y][VRAM_TILES_X];
+};
+
+static VramState* pVramState;
+
+// ***********************************************************************
+
+void Init(Arena* pArena) {
+	pVramState = New(pArena, VramState);
+	pVramState->pPixels = New(pArena, u16, VRAM_WIDTH * VRAM_HEIGHT);
+	memset(pVramState->pPixels, 0, VRAM_WIDTH * VRAM_HEIGHT * sizeof(u16));
+	memset(pVramState->dirtyTiles, 0, sizeof(pVramState->dirtyTiles));
+
+	// sokol can only replace whole images, so this one is made by the platform layer to allow partial updates
+	pVramState->image = CreatePartialUpdateImage(VRAM_WIDTH, VRAM_HEIGHT, SG_PIXELFORMAT_R16UI, pVramState->pPixels);
+}
+
+// ***********************************************************************
+
+u16* GetPixels() {
+	return pVramState->pPixels;
+}
+
+// ***********************************************************************
+
+sg_image GetImage() {
+	return pVramState->image;
+}
+
+// ***********************************************************************
+
+void MarkDirty(i32 x, i32 y, i32 width, i32 height) {
+	if (width <= 0 || height <= 0)
+		return;
+
+	i32 minX = clamp(x, 0, VRAM_WIDTH - 1) / VRAM_TILE_SIZE;
+	i32 minY = clamp(y, 0, VRAM_HEIGHT - 1) / VRAM_TILE_SIZE;
+	i32 maxX = clamp(x + width - 1, 0, VRAM_WIDTH - 1) / VRAM_TILE_SIZE;
+	i32 maxY = clamp(y + height - 1, 0, VRAM_HEIGHT - 1) / VRAM_TILE_SIZE;
+
+	for (i32 ty = minY; ty <= maxY; ty++) {
+		for (i32 tx = minX; tx <= maxX; tx++) {
+			pVramState->dirtyTiles[ty][tx] = true;
+		}
+	}
+}
+
+// ***********************************************************************
+
+void CollectUploads(ResizableArray<VramUpload>& uploads, ResizableArray<u16>& pixels) {
+	// runs on the simulation thread, copying the pixels out means scripts can keep
+	// writing to vram while the render thread uploads this frame's copy
+	i64 bytes = 0;
+	for (i32 ty = 0; ty < VRAM_TILES_Y; ty++) {
+		for (i32 tx = 0; tx < VRAM_TILES_X; tx++) {
+			if (!pVramState->dirtyTiles[ty][tx])
+				continue;
+
+			// merge runs of dirty tiles along the row into one upload
+			i32 runStart = tx;
+			while (tx < VRAM_TILES_X && pVramState->dirtyTiles[ty][tx]) {
+				pVramState->dirtyTiles[ty][tx] = false;
+				tx++;
+			}
+
+			VramUpload upload;
+			upload.x = runStart * VRAM_TILE_SIZE;
+			upload.y = ty * VRAM_TILE_SIZE;
+			upload.width = (tx - runStart) * VRAM_TILE_SIZE;
+			upload.height = VRAM_TILE_SIZE;
+			upload.offset = pixels.count;
+
+			// frames reserve room for all of vram up front, so this never grows
+			pixels.Reserve(pixels.count + upload.width * upload.height);
+			for (i32 row = 0; row < upload.height; row++) {
+				memcpy(pixels.pData + pixels.count, pVramState->pPixels + (upload.y + row) * VRAM_WIDTH + upload.x, upload.width * sizeof(u16));
+				pixels.count += upload.width;
+			}
+			uploads.PushBack(upload);
+			bytes += upload.width * upload.height * sizeof(u16);
+		}
+	}
+
+	if (bytes > 0) {
+		RecordTextureUpload(pVramState->image, bytes);
+	}
+}
+
+// ***********************************************************************
+
+void ApplyUploads(ResizableArray<VramUpload>& uploads, ResizableArray<u16>& pixels) {
+	// render thread
+	for (i64 i = 0; i < uploads.count; i++) {
+		VramUpload& upload = uploads[i];
+		UpdateImageRegion(pVramState->image, upload.x, upload.y, upload.width, upload.height, pixels.pData + upload.offset, upload.width * sizeof(u16));
+	}
+}
+
+}
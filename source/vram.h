@@ -0,0 +1,29 @@
+// Copyright 2020-2022 David Colson. All rights reserved.
+
+#pragma once
+
+// A ps1 style 1MB vram, a single 16 bit surface holding texture pages and cluts
+#define VRAM_WIDTH 1024
+#define VRAM_HEIGHT 512
+#define VRAM_TILE_SIZE 64
+
+// A dirty rect copied out of vram for the render thread to upload
+struct VramUpload {
+	i32 x;
+	i32 y;
+	i32 width;
+	i32 height;
+	i64 offset; // into the frame's vram pixels
+};
+
+namespace Vram {
+
+void Init(Arena* pArena);
+u16* GetPixels();
+sg_image GetImage();
+
+void MarkDirty(i32 x, i32 y, i32 width, i32 height);
+void CollectUploads(ResizableArray<VramUpload>& uploads, ResizableArray<u16>& pixels);
+void ApplyUploads(ResizableArray<VramUpload>& uploads, ResizableArray<u16>& pixels);
+
+}